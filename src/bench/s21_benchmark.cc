@@ -0,0 +1,693 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include "../s21_matrix_oop.h"
+#include "../s21_cholesky.h"
+#include "../s21_eigen.h"
+#include "../s21_fixed_matrix.h"
+#include "../s21_lu.h"
+#include "../s21_matrix_batch.h"
+#include "../s21_qr.h"
+#include "../s21_sparse_matrix.h"
+#include "../s21_vector.h"
+
+//=================   ALLOCATION COUNTING   ======================
+// the replacements below pair malloc with free, which GCC cannot see
+// through once they are inlined into each other
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+static std::atomic<long> allocations{0};
+
+void *operator new(std::size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *ptr = std::malloc(size ? size : 1)) return ptr;
+  throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, std::align_val_t align) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  const std::size_t alignment = static_cast<std::size_t>(align);
+  size = (size + alignment - 1) / alignment * alignment;
+  if (void *ptr = std::aligned_alloc(alignment, size ? size : alignment))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+
+//=================   HELPERS   ======================
+
+// diagonally dominant, so every size is safely invertible
+template <typename T = double>
+static S21BasicMatrix<T> Filled(int rows, int cols) {
+  S21BasicMatrix<T> matrix(rows, cols);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) {
+      matrix(i, j) = ((i * 31 + j * 17) % 23) / 23.0 + (i == j) * cols;
+    }
+  }
+  return matrix;
+}
+
+// flops and bytes are per iteration; allocations are averaged over them
+static void Report(benchmark::State &state, double flops, double bytes,
+                   long allocsBefore) {
+  const double iterations = state.iterations();
+  state.counters["FLOP/s"] =
+      benchmark::Counter(flops * iterations, benchmark::Counter::kIsRate);
+  state.SetBytesProcessed(static_cast<int64_t>(bytes * iterations));
+  state.counters["allocs"] =
+      benchmark::Counter(allocations - allocsBefore,
+                         benchmark::Counter::kAvgIterations);
+}
+
+#define ELEMENTS(rows, cols) (double(rows) * (cols))
+#define BYTES(rows, cols) (ELEMENTS(rows, cols) * sizeof(double))
+#define BYTES_OF(T, rows, cols) (ELEMENTS(rows, cols) * sizeof(T))
+
+//=================   CONSTRUCTION   ======================
+
+static void BM_Construct(benchmark::State &state) {
+  const int n = state.range(0);
+  const long before = allocations;
+  for (auto _ : state) {
+    S21Matrix matrix(n, n);
+    benchmark::DoNotOptimize(&matrix(0, 0));
+  }
+  Report(state, 0, BYTES(n, n), before);
+}
+
+static void BM_Copy(benchmark::State &state) {
+  const int n = state.range(0);
+  S21Matrix source = Filled(n, n);
+  const long before = allocations;
+  for (auto _ : state) {
+    S21Matrix copy(source);
+    benchmark::DoNotOptimize(&copy(0, 0));
+  }
+  Report(state, 0, 2 * BYTES(n, n), before);
+}
+
+static void BM_Move(benchmark::State &state) {
+  const int n = state.range(0);
+  S21Matrix first = Filled(n, n), second;
+  const long before = allocations;
+  for (auto _ : state) {
+    second = std::move(first);
+    first = std::move(second);
+    benchmark::ClobberMemory();
+  }
+  Report(state, 0, 0, before);
+}
+
+static void BM_SetRows(benchmark::State &state) {
+  const int n = state.range(0);
+  S21Matrix matrix = Filled(n, n);
+  const long before = allocations;
+  int grow = 0;
+  for (auto _ : state) {
+    matrix.SetRows(n + (grow ^= 1));
+    benchmark::DoNotOptimize(&matrix(0, 0));
+  }
+  Report(state, 0, 2 * BYTES(n, n), before);
+}
+
+//=================   ARITHMETIC   ======================
+
+template <typename T>
+static void BM_SumMatrix(benchmark::State &state) {
+  const int n = state.range(0);
+  S21BasicMatrix<T> first = Filled<T>(n, n), second = Filled<T>(n, n);
+  const long before = allocations;
+  for (auto _ : state) {
+    first.SumMatrix(second);
+    benchmark::ClobberMemory();
+  }
+  Report(state, ELEMENTS(n, n), 3 * BYTES_OF(T, n, n), before);
+}
+
+static void BM_ExpressionChain(benchmark::State &state) {
+  const int n = state.range(0);
+  S21Matrix a = Filled(n, n), b = Filled(n, n), c = Filled(n, n), result;
+  const long before = allocations;
+  for (auto _ : state) {
+    result = a + b - c * 2.0;
+    benchmark::DoNotOptimize(&result(0, 0));
+  }
+  Report(state, 3 * ELEMENTS(n, n), 4 * BYTES(n, n), before);
+}
+
+// one quadrant into another through views: no copies, no allocations
+static void BM_BlockSumMatrix(benchmark::State &state) {
+  const int n = state.range(0), half = n / 2;
+  S21Matrix matrix = Filled(n, n);
+  const long before = allocations;
+  for (auto _ : state) {
+    matrix.Block(0, 0, half, half) += matrix.Block(half, half, half, half);
+    benchmark::ClobberMemory();
+  }
+  Report(state, ELEMENTS(half, half), 3 * BYTES(half, half), before);
+}
+
+template <typename T>
+static void BM_MulMatrix(benchmark::State &state) {
+  const int m = state.range(0), k = state.range(1), n = state.range(2);
+  S21BasicMatrix<T> first = Filled<T>(m, k), second = Filled<T>(k, n);
+  const long before = allocations;
+  for (auto _ : state) {
+    S21BasicMatrix<T> product = first * second;
+    benchmark::DoNotOptimize(&product(0, 0));
+  }
+  Report(state, 2.0 * m * n * k,
+         BYTES_OF(T, m, k) + BYTES_OF(T, k, n) + BYTES_OF(T, m, n), before);
+}
+
+//=================   VECTORS   ======================
+
+static S21Vector FilledVector(int size) {
+  S21Vector vector(size);
+  FOR(size) vector(i) = i % 7 - 3;
+  return vector;
+}
+
+static void BM_MulVector(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21Matrix matrix = Filled(n, n);
+  const S21Vector x = FilledVector(n);
+  S21Vector y(n);
+  const long before = allocations;
+  for (auto _ : state) {
+    matrix.Mul(x, y);
+    benchmark::DoNotOptimize(y.Data());
+  }
+  Report(state, 2.0 * n * n, BYTES(n, n), before);
+}
+
+static void BM_MulTransposedVector(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21Matrix matrix = Filled(n, n);
+  const S21Vector x = FilledVector(n);
+  S21Vector y(n);
+  const long before = allocations;
+  for (auto _ : state) {
+    matrix.MulTransposed(x, y);
+    benchmark::DoNotOptimize(y.Data());
+  }
+  Report(state, 2.0 * n * n, BYTES(n, n), before);
+}
+
+// the same product through an n x 1 matrix, for comparison
+static void BM_MulColumnMatrix(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21Matrix matrix = Filled(n, n), column = Filled(n, 1);
+  const long before = allocations;
+  for (auto _ : state) {
+    S21Matrix product = matrix * column;
+    benchmark::DoNotOptimize(&product(0, 0));
+  }
+  Report(state, 2.0 * n * n, BYTES(n, n), before);
+}
+
+//=================   FACTORIZATIONS   ======================
+
+static S21Matrix Invertible(int n) {
+  S21Matrix matrix = Filled(n, n);
+  FOR(n) matrix(i, i) += n;
+  return matrix;
+}
+
+static void BM_LUFactor(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21Matrix matrix = Invertible(n);
+  const long before = allocations;
+  for (auto _ : state) {
+    S21LU lu(matrix);
+    benchmark::DoNotOptimize(lu.Determinant());
+  }
+  Report(state, 2.0 / 3 * n * n * n, BYTES(n, n), before);
+}
+
+// one more right-hand side against factors already made
+static void BM_LUSolve(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21LU lu(Invertible(n));
+  const S21Vector b = FilledVector(n);
+  S21Vector x = b;
+  const long before = allocations;
+  for (auto _ : state) {
+    x = b;
+    lu.SolveInPlace(x);
+    benchmark::DoNotOptimize(x.Data());
+  }
+  Report(state, 2.0 * n * n, BYTES(n, n), before);
+}
+
+static void BM_CholeskyFactor(benchmark::State &state) {
+  const int n = state.range(0);
+  S21Matrix matrix = Filled(n, n);
+  matrix = matrix * matrix.Transpose();
+  FOR(n) matrix(i, i) += n;
+  const long before = allocations;
+  for (auto _ : state) {
+    S21Cholesky llt(matrix);
+    benchmark::DoNotOptimize(llt.LogDeterminant());
+  }
+  Report(state, 1.0 / 3 * n * n * n, BYTES(n, n), before);
+}
+
+// a tall regression: factor, then one least-squares solve
+static void BM_QRLeastSquares(benchmark::State &state) {
+  const int m = state.range(0), n = state.range(1);
+  S21Matrix matrix = Filled(m, n);
+  FOR(n) matrix(i, i) += m;
+  const S21Vector b = FilledVector(m);
+  const long before = allocations;
+  for (auto _ : state) {
+    const S21Vector x = S21QR(matrix).LeastSquares(b);
+    benchmark::DoNotOptimize(x.Data());
+  }
+  Report(state, 2.0 * m * n * n - 2.0 / 3 * n * n * n, BYTES(m, n), before);
+}
+
+// a PCA job: count 0 takes every pair, -1 the eigenvalues alone, and
+// anything else that many of the largest pairs
+static void BM_SymmetricEigen(benchmark::State &state) {
+  const int n = state.range(0), count = state.range(1);
+  S21Matrix matrix = Filled(n, n);
+  matrix = matrix * matrix.Transpose();
+  const long before = allocations;
+  for (auto _ : state) {
+    S21SymmetricEigen eigen = count > 0   ? S21SymmetricEigen(matrix, count)
+                              : count < 0 ? S21SymmetricEigen(matrix, false)
+                                          : S21SymmetricEigen(matrix);
+    benchmark::DoNotOptimize(eigen.GetValues().Data());
+  }
+  // the reduction, plus carrying n vectors back when there are n
+  Report(state, (count ? 4.0 / 3 : 10.0 / 3) * n * n * n, BYTES(n, n),
+         before);
+}
+
+//=================   OPERATIONS   ======================
+
+static void BM_Transpose(benchmark::State &state) {
+  const int rows = state.range(0), cols = state.range(1);
+  S21Matrix matrix = Filled(rows, cols);
+  const long before = allocations;
+  for (auto _ : state) {
+    S21Matrix transposed = matrix.Transpose();
+    benchmark::DoNotOptimize(&transposed(0, 0));
+  }
+  Report(state, 0, 2 * BYTES(rows, cols), before);
+}
+
+static void BM_TransposeInPlace(benchmark::State &state) {
+  const int n = state.range(0);
+  S21Matrix matrix = Filled(n, n);
+  const long before = allocations;
+  for (auto _ : state) {
+    matrix.TransposeInPlace();
+    benchmark::ClobberMemory();
+  }
+  Report(state, 0, 2 * BYTES(n, n), before);
+}
+
+static void BM_Determinant(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21Matrix matrix = Filled(n, n);
+  const long before = allocations;
+  for (auto _ : state) benchmark::DoNotOptimize(matrix.Determinant());
+  Report(state, 2.0 / 3 * n * n * n, BYTES(n, n), before);
+}
+
+static void BM_CalcComplements(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21Matrix matrix = Filled(n, n);
+  const long before = allocations;
+  for (auto _ : state) {
+    S21Matrix complements = matrix.CalcComplements();
+    benchmark::DoNotOptimize(&complements(0, 0));
+  }
+  Report(state, 2.0 * n * n * n, 2 * BYTES(n, n), before);
+}
+
+static void BM_InverseMatrix(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21Matrix matrix = Filled(n, n);
+  const long before = allocations;
+  for (auto _ : state) {
+    S21Matrix inverse = matrix.InverseMatrix();
+    benchmark::DoNotOptimize(&inverse(0, 0));
+  }
+  Report(state, 2.0 * n * n * n, 2 * BYTES(n, n), before);
+}
+
+//=================   FIXED SIZE   ======================
+
+template <int N>
+static void BM_FixedMulMatrix(benchmark::State &state) {
+  S21FixedMatrix<N, N> first(Filled(N, N)), second(Filled(N, N));
+  const long before = allocations;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(first);
+    S21FixedMatrix<N, N> product = first * second;
+    benchmark::DoNotOptimize(product);
+  }
+  Report(state, 2.0 * N * N * N, 3 * BYTES(N, N), before);
+}
+
+template <int N>
+static void BM_FixedInverseMatrix(benchmark::State &state) {
+  S21FixedMatrix<N, N> matrix(Filled(N, N));
+  const long before = allocations;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(matrix);
+    S21FixedMatrix<N, N> inverse = matrix.InverseMatrix();
+    benchmark::DoNotOptimize(inverse);
+  }
+  Report(state, 0, 2 * BYTES(N, N), before);
+}
+
+//=================   BATCHES   ======================
+
+#define BATCH_COUNT 10000
+
+static S21MatrixBatch FilledBatch(int n) {
+  S21MatrixBatch batch(BATCH_COUNT, n, n);
+  const S21Matrix matrix = Filled(n, n);
+  for (int b = 0; b < BATCH_COUNT; b++) {
+    batch.SetMatrix(b, matrix);
+    batch(b, 0, 0) += b % 7;
+  }
+  return batch;
+}
+
+static void BM_BatchMulMatrix(benchmark::State &state) {
+  const int n = state.range(0);
+  S21MatrixBatch first = FilledBatch(n);
+  const S21MatrixBatch second = FilledBatch(n);
+  const long before = allocations;
+  for (auto _ : state) {
+    state.PauseTiming();
+    S21MatrixBatch product = first;
+    state.ResumeTiming();
+    product.BatchMulMatrix(second);
+    benchmark::DoNotOptimize(&product(0, 0, 0));
+  }
+  Report(state, 2.0 * n * n * n * BATCH_COUNT, 3 * BATCH_COUNT * BYTES(n, n),
+         before);
+}
+
+static void BM_BatchDeterminant(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21MatrixBatch batch = FilledBatch(n);
+  const long before = allocations;
+  for (auto _ : state) benchmark::DoNotOptimize(batch.BatchDeterminant());
+  Report(state, 2.0 / 3 * n * n * n * BATCH_COUNT, BATCH_COUNT * BYTES(n, n),
+         before);
+}
+
+static void BM_BatchInverse(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21MatrixBatch batch = FilledBatch(n);
+  const long before = allocations;
+  for (auto _ : state) {
+    S21MatrixBatch inverse = batch.BatchInverse();
+    benchmark::DoNotOptimize(&inverse(0, 0, 0));
+  }
+  Report(state, 2.0 * n * n * n * BATCH_COUNT, 2 * BATCH_COUNT * BYTES(n, n),
+         before);
+}
+
+// the entries of FilledBatch(n) as separate matrices, for the loops below
+static std::vector<S21Matrix> BatchEntries(int n) {
+  const S21MatrixBatch batch = FilledBatch(n);
+  std::vector<S21Matrix> matrices;
+  for (int b = 0; b < BATCH_COUNT; b++) matrices.push_back(batch.GetMatrix(b));
+  return matrices;
+}
+
+// the same products, determinants and inverses one S21Matrix at a time,
+// kept as the batch keeps its results
+static void BM_LoopMulMatrix(benchmark::State &state) {
+  const int n = state.range(0);
+  const std::vector<S21Matrix> matrices = BatchEntries(n);
+  const long before = allocations;
+  for (auto _ : state) {
+    std::vector<S21Matrix> products;
+    products.reserve(BATCH_COUNT);
+    for (const S21Matrix &matrix : matrices)
+      products.push_back(matrix * matrix);
+    benchmark::DoNotOptimize(products.data());
+  }
+  Report(state, 2.0 * n * n * n * BATCH_COUNT, 3 * BATCH_COUNT * BYTES(n, n),
+         before);
+}
+
+static void BM_LoopDeterminant(benchmark::State &state) {
+  const int n = state.range(0);
+  const std::vector<S21Matrix> matrices = BatchEntries(n);
+  const long before = allocations;
+  for (auto _ : state) {
+    for (const S21Matrix &matrix : matrices)
+      benchmark::DoNotOptimize(matrix.Determinant());
+  }
+  Report(state, 2.0 / 3 * n * n * n * BATCH_COUNT, BATCH_COUNT * BYTES(n, n),
+         before);
+}
+
+static void BM_LoopInverse(benchmark::State &state) {
+  const int n = state.range(0);
+  const std::vector<S21Matrix> matrices = BatchEntries(n);
+  const long before = allocations;
+  for (auto _ : state) {
+    std::vector<S21Matrix> inverses;
+    inverses.reserve(BATCH_COUNT);
+    for (const S21Matrix &matrix : matrices)
+      inverses.push_back(matrix.InverseMatrix());
+    benchmark::DoNotOptimize(inverses.data());
+  }
+  Report(state, 2.0 * n * n * n * BATCH_COUNT, 2 * BATCH_COUNT * BYTES(n, n),
+         before);
+}
+
+//=================   PERSISTENCE   ======================
+
+#define BENCH_FILE "/tmp/s21_bench_matrix.bin"
+
+static void BM_Save(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21Matrix matrix = Filled(n, n);
+  const long before = allocations;
+  for (auto _ : state) matrix.Save(BENCH_FILE);
+  Report(state, 0, BYTES(n, n), before);
+  std::remove(BENCH_FILE);
+}
+
+// cost is the mapping alone, independent of n, until pages are touched
+static void BM_OpenMapped(benchmark::State &state) {
+  const int n = state.range(0);
+  Filled(n, n).Save(BENCH_FILE);
+  const long before = allocations;
+  for (auto _ : state) {
+    const S21Matrix mapped = S21Matrix::OpenMapped(BENCH_FILE);
+    benchmark::DoNotOptimize(mapped.GetRows());
+  }
+  Report(state, 0, 0, before);
+  std::remove(BENCH_FILE);
+}
+
+// tiles from files under a 16 MiB budget against the in-memory product
+static void BM_ProductOutOfCore(benchmark::State &state) {
+  const int n = state.range(0);
+  Filled(n, n).Save(BENCH_FILE);
+  const long before = allocations;
+  for (auto _ : state)
+    S21Matrix::ProductOutOfCore(BENCH_FILE, BENCH_FILE, BENCH_FILE ".out",
+                                std::size_t(16) << 20);
+  Report(state, 2.0 * n * n * n, 3 * BYTES(n, n), before);
+  std::remove(BENCH_FILE), std::remove(BENCH_FILE ".out");
+}
+
+//=================   SPARSE   ======================
+
+// n x n with perRow entries per row, scattered over the columns
+static S21SparseMatrix Scattered(int n, int perRow) {
+  std::vector<int> rowPtr(n + 1), colIndex;
+  std::vector<double> values;
+  for (int i = 0; i < n; i++) {
+    for (int k = 0; k < perRow; k++) {
+      colIndex.push_back(int((long(i) * 7919 + long(k) * n / perRow) % n));
+      values.push_back(1.0 + (i + k) % 5);
+    }
+    std::sort(colIndex.end() - perRow, colIndex.end());
+    rowPtr[i + 1] = rowPtr[i] + perRow;
+  }
+  return S21SparseMatrix(n, n, rowPtr, colIndex, values);
+}
+
+// time and memory follow nnz = n * perRow, not n * n
+static void BM_SparseSumMatrix(benchmark::State &state) {
+  const int n = state.range(0), perRow = state.range(1);
+  const S21SparseMatrix first = Scattered(n, perRow),
+                        second = Scattered(n, perRow).Transpose();
+  const long before = allocations;
+  for (auto _ : state) {
+    S21SparseMatrix sum = first + second;
+    benchmark::DoNotOptimize(sum.GetValues().data());
+  }
+  Report(state, 2.0 * n * perRow, 2 * BYTES_OF(double, n, perRow), before);
+}
+
+static void BM_SparseMulDense(benchmark::State &state) {
+  const int n = state.range(0), perRow = state.range(1), cols = 64;
+  const S21SparseMatrix first = Scattered(n, perRow);
+  const S21Matrix second = Filled(n, cols);
+  const long before = allocations;
+  for (auto _ : state) {
+    S21Matrix product = first * second;
+    benchmark::DoNotOptimize(&product(0, 0));
+  }
+  Report(state, 2.0 * n * perRow * cols, 2 * BYTES(n, cols), before);
+}
+
+static void BM_SparseMulSparse(benchmark::State &state) {
+  const int n = state.range(0), perRow = state.range(1);
+  const S21SparseMatrix first = Scattered(n, perRow),
+                        second = Scattered(n, perRow);
+  const long before = allocations;
+  for (auto _ : state) {
+    S21SparseMatrix product = first * second;
+    benchmark::DoNotOptimize(product.GetValues().data());
+  }
+  Report(state, 2.0 * n * perRow * perRow, 2 * BYTES_OF(double, n, perRow),
+         before);
+}
+
+//=================   SWEEPS   ======================
+
+BENCHMARK(BM_Construct)->RangeMultiplier(4)->Range(4, 2048);
+BENCHMARK(BM_Copy)->RangeMultiplier(4)->Range(4, 2048);
+BENCHMARK(BM_Move)->RangeMultiplier(4)->Range(4, 2048);
+BENCHMARK(BM_SetRows)->RangeMultiplier(4)->Range(4, 2048);
+BENCHMARK_TEMPLATE(BM_SumMatrix, double)->RangeMultiplier(4)->Range(4, 2048);
+BENCHMARK_TEMPLATE(BM_SumMatrix, float)->RangeMultiplier(4)->Range(4, 2048);
+BENCHMARK(BM_ExpressionChain)->RangeMultiplier(4)->Range(4, 2048);
+BENCHMARK(BM_BlockSumMatrix)->RangeMultiplier(4)->Range(8, 2048);
+BENCHMARK_TEMPLATE(BM_MulMatrix, double)
+    ->ArgsProduct({{64, 256, 1024}, {64, 256, 1024}, {64, 256, 1024}})
+    ->Args({2048, 2048, 2048})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_MulMatrix, float)
+    ->Args({256, 256, 256})
+    ->Args({1024, 1024, 1024})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MulVector)
+    ->RangeMultiplier(8)
+    ->Range(64, 4096)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_MulTransposedVector)
+    ->RangeMultiplier(8)
+    ->Range(64, 4096)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_MulColumnMatrix)
+    ->RangeMultiplier(8)
+    ->Range(64, 4096)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_LUFactor)
+    ->RangeMultiplier(4)
+    ->Range(64, 1024)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_LUSolve)
+    ->RangeMultiplier(4)
+    ->Range(64, 1024)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_CholeskyFactor)
+    ->RangeMultiplier(4)
+    ->Range(64, 1024)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_QRLeastSquares)
+    ->ArgsProduct({{4096, 65536}, {64, 200}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SymmetricEigen)
+    ->ArgsProduct({{500, 2000}, {0, -1, 10}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Transpose)
+    ->ArgsProduct({{64, 512, 4096}, {64, 512, 4096}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_TransposeInPlace)
+    ->RangeMultiplier(8)
+    ->Range(64, 4096)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Determinant)->RangeMultiplier(2)->Range(4, 512);
+BENCHMARK(BM_CalcComplements)->RangeMultiplier(2)->Range(4, 512);
+BENCHMARK(BM_InverseMatrix)->RangeMultiplier(2)->Range(4, 512);
+
+BENCHMARK_TEMPLATE(BM_FixedMulMatrix, 2);
+BENCHMARK_TEMPLATE(BM_FixedMulMatrix, 3);
+BENCHMARK_TEMPLATE(BM_FixedMulMatrix, 4);
+BENCHMARK_TEMPLATE(BM_FixedInverseMatrix, 2);
+BENCHMARK_TEMPLATE(BM_FixedInverseMatrix, 3);
+BENCHMARK_TEMPLATE(BM_FixedInverseMatrix, 4);
+
+BENCHMARK(BM_BatchMulMatrix)
+    ->Arg(3)
+    ->Arg(8)
+    ->Arg(32)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_BatchDeterminant)
+    ->Arg(3)
+    ->Arg(8)
+    ->Arg(32)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_BatchInverse)
+    ->Arg(3)
+    ->Arg(8)
+    ->Arg(32)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_LoopMulMatrix)
+    ->Arg(3)
+    ->Arg(8)
+    ->Arg(32)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_LoopDeterminant)
+    ->Arg(3)
+    ->Arg(8)
+    ->Arg(32)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_LoopInverse)
+    ->Arg(3)
+    ->Arg(8)
+    ->Arg(32)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Save)
+    ->RangeMultiplier(8)
+    ->Range(64, 4096)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_OpenMapped)
+    ->RangeMultiplier(8)
+    ->Range(64, 4096)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ProductOutOfCore)
+    ->RangeMultiplier(2)
+    ->Range(512, 2048)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SparseSumMatrix)
+    ->ArgsProduct({{1 << 10, 1 << 14, 1 << 18}, {4, 32}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SparseMulDense)
+    ->ArgsProduct({{1 << 10, 1 << 14, 1 << 16}, {4, 32}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SparseMulSparse)
+    ->ArgsProduct({{1 << 10, 1 << 14, 1 << 18}, {4, 32}})
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
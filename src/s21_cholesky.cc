@@ -0,0 +1,179 @@
+#include "s21_cholesky.h"
+
+#include "s21_gemm.h"
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+
+#define TMPL template <typename T>
+#define MAT S21BasicMatrix<T>
+#define CHOLESKY S21BasicCholesky<T>
+// columns per panel, and rows per block of the trailing update
+#define CHOLESKY_BLOCK 64
+
+// sum of x[p] * conj(y[p]); real types take the dot kernel
+template <typename T>
+static T DotConj(int n, const T *x, const T *y) {
+  if constexpr (std::is_floating_point_v<T>) {
+    return S21GetKernels<T>().dot(n, x, y);
+  } else {
+    T sum = T();
+    for (int p = 0; p < n; ++p) sum += x[p] * S21Conj(y[p]);
+    return sum;
+  }
+}
+
+// x[p] += alpha * conj(y[p]); real types take the axpy kernel
+template <typename T>
+static void AxpyConj(int n, T *x, const T *y, T alpha) {
+  if constexpr (std::is_floating_point_v<T>)
+    S21GetKernels<T>().axpy(n, x, y, alpha);
+  else
+    for (int p = 0; p < n; ++p) x[p] += alpha * S21Conj(y[p]);
+}
+
+//=================   FACTORIZATION   ======================
+
+// In-place lower Cholesky, right-looking in CHOLESKY_BLOCK-column panels.
+// Within a panel each column is scaled by its pivot and subtracted from the
+// panel columns to its right in every row below; then the trailing lower
+// triangle takes the rank-CHOLESKY_BLOCK update through S21Gemm one block
+// row at a time, so the strict upper triangle is left unspecified. Throws
+// at the first pivot that is not positive.
+TMPL void MAT::FactorCholesky() {
+  S21_PROFILE_SCOPE(FactorCholesky);
+  CheckSquare();
+  Detach();
+  const int n = rows_;
+  S21BasicMatrix panel;  // -L21^H of the current panel, the Gemm rhs
+  if (n > CHOLESKY_BLOCK)
+    panel = S21BasicMatrix(CHOLESKY_BLOCK, n - CHOLESKY_BLOCK);
+  T column[CHOLESKY_BLOCK];  // conj(L(j, k)) for the panel rows j > k
+  for (int k0 = 0; k0 < n; k0 += CHOLESKY_BLOCK) {
+    const int end = std::min(k0 + CHOLESKY_BLOCK, n), nb = end - k0;
+    for (int k = k0; k < end; ++k) {
+      const auto d = std::real(RowPtr(k)[k]);
+      if (!(d > 0)) throw std::logic_error("Matrix is not positive definite");
+      const T root = RowPtr(k)[k] = std::sqrt(d);
+      for (int j = k + 1; j < end; ++j)
+        column[j - k0] = S21Conj(RowPtr(j)[k] /= root);
+      S21ParallelRows(k + 1, n, end - k, [&](int from, int to) {
+        for (int i = from; i < to; ++i) {
+          T *row = RowPtr(i), l = i < end ? row[k] : (row[k] /= root);
+          const int last = std::min(i + 1, end);
+          for (int j = k + 1; j < last; ++j) row[j] -= l * column[j - k0];
+        }
+      });
+    }
+    if (end == n) break;
+    // A22 -= L21 * L21^H on and below the diagonal blocks
+    for (int i = end; i < n; ++i)
+      for (int p = 0; p < nb; ++p)
+        panel.RowPtr(p)[i - end] = -S21Conj(RowPtr(i)[k0 + p]);
+    for (int r0 = end; r0 < n; r0 += CHOLESKY_BLOCK) {
+      const int r1 = std::min(r0 + CHOLESKY_BLOCK, n);
+      S21Gemm(r1 - r0, r1 - end, nb, RowPtr(r0) + k0, stride_,
+              panel.matrix_, panel.stride_, RowPtr(r0) + end, stride_);
+    }
+  }
+}
+
+// Overwrites rhs with the solution of A * X = rhs, the lower triangle of
+// *this holding FactorCholesky(A). Columns of rhs go to the pool in blocks.
+TMPL void MAT::SolveCholesky(MAT &rhs) const {
+  S21_PROFILE_SCOPE(SolveCholesky);
+  rhs.Detach();
+  const int n = rows_;
+  S21ParallelRows(0, rhs.cols_, n * n, [&](int from, int to) {
+    const int m = to - from;
+    // L * Y = rhs
+    FOR(n) {
+      T *x = rhs.RowPtr(i) + from;
+      for (int k = 0; k < i; ++k) {
+        const T l = RowPtr(i)[k], *y = rhs.RowPtr(k) + from;
+        for (int j = 0; j < m; ++j) x[j] -= l * y[j];
+      }
+      const T d = T(1) / RowPtr(i)[i];
+      for (int j = 0; j < m; ++j) x[j] *= d;
+    }
+    // L^H * X = Y: once row i is final it leaves the rows above
+    for (int i = n - 1; i >= 0; --i) {
+      T *x = rhs.RowPtr(i) + from;
+      const T d = T(1) / RowPtr(i)[i];
+      for (int j = 0; j < m; ++j) x[j] *= d;
+      for (int k = 0; k < i; ++k) {
+        const T l = S21Conj(RowPtr(i)[k]);
+        T *y = rhs.RowPtr(k) + from;
+        for (int j = 0; j < m; ++j) y[j] -= l * x[j];
+      }
+    }
+  });
+}
+
+//=================  CONSTRUCTORS   ======================
+
+TMPL CHOLESKY::S21BasicCholesky(const S21BasicMatrix<T> &matrix)
+    : factor_(matrix) {
+  factor_.FactorCholesky();
+  const int n = GetSize();
+  for (int i = 0; i + 1 < n; ++i)
+    factor_.Block(i, i + 1, 1, n - i - 1).Fill(T());
+}
+
+//=================   OPERATIONS   ======================
+
+TMPL typename CHOLESKY::Real CHOLESKY::LogDeterminant() const {
+  Real sum = 0;
+  FOR(GetSize()) sum += std::log(std::real(factor_.Row(i).Data()[i]));
+  return 2 * sum;
+}
+
+TMPL S21BasicMatrix<T> CHOLESKY::Inverse() const {
+  S21BasicMatrix<T> result(GetSize(), GetSize());
+  FOR(GetSize()) result(i, i) = 1;
+  return SolveInPlace(result), result;
+}
+
+TMPL S21BasicVector<T> CHOLESKY::Solve(const S21BasicVector<T> &b) const {
+  S21BasicVector<T> x = b;
+  return SolveInPlace(x), x;
+}
+
+TMPL S21BasicMatrix<T> CHOLESKY::Solve(const S21BasicMatrix<T> &b) const {
+  S21BasicMatrix<T> x = b;
+  return SolveInPlace(x), x;
+}
+
+// L * y = b by rows, then L^H * x = y by scattering each finished entry
+TMPL void CHOLESKY::SolveInPlace(S21BasicVector<T> &b) const {
+  CheckSolvable(b.GetSize());
+  const S21Kernels<T> &kernels = S21GetKernels<T>();
+  const int n = GetSize();
+  T *x = b.Data();
+  FOR(n) {
+    const T *l = factor_.Row(i).Data();
+    x[i] = (x[i] - kernels.dot(i, l, x)) / l[i];
+  }
+  for (int i = n - 1; i >= 0; --i) {
+    const T *l = factor_.Row(i).Data();
+    x[i] /= l[i];
+    AxpyConj(i, x, l, -x[i]);
+  }
+}
+
+TMPL void CHOLESKY::SolveInPlace(S21BasicMatrix<T> &b) const {
+  CheckSolvable(b.GetRows());
+  factor_.SolveCholesky(b);
+}
+
+//=================   SUPPLEMENTARY   ======================
+
+TMPL void CHOLESKY::CheckSolvable(int rows) const {
+  if (rows != GetSize()) throw std::invalid_argument("Invalid sizes");
+}
+
+#define INSTANTIATE(T)                                                     \
+  template void S21BasicMatrix<T>::FactorCholesky();                       \
+  template void S21BasicMatrix<T>::SolveCholesky(S21BasicMatrix<T> &)      \
+      const;                                                               \
+  template class S21BasicCholesky<T>;
+S21_FLOATING_TYPES(INSTANTIATE)
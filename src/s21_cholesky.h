@@ -0,0 +1,50 @@
+#ifndef S21_CHOLESKY_H
+#define S21_CHOLESKY_H
+
+#include "s21_matrix_oop.h"
+
+//=================   CHOLESKY FACTORIZATION   ======================
+// A = L * L^H for symmetric (Hermitian) positive-definite A, with half the
+// flops and none of the pivoting of LU. Only the lower triangle of A is
+// read. Factoring stops at the first pivot that is not positive, so a
+// matrix that is not positive definite throws straight away. For the types
+// in S21_FLOATING_TYPES.
+
+template <typename T>
+class S21BasicCholesky {
+  static_assert(!S21Traits<T>::kExact, "Cholesky takes square roots");
+
+ public:
+  using Scalar = T;
+  using Real = typename S21Traits<T>::Real;
+
+  //=================  CONSTRUCTORS   ======================
+  explicit S21BasicCholesky(const S21BasicMatrix<T>& matrix);
+
+  //=================   GET   ======================
+  int GetSize() const { return factor_.GetRows(); }
+  // L, zero above the diagonal
+  const S21BasicMatrix<T>& GetFactor() const { return factor_; }
+
+  //=================   OPERATIONS   ======================
+  // log det A = 2 * sum of log L(i, i), finite where det A over- or
+  // underflows
+  Real LogDeterminant() const;
+  S21BasicMatrix<T> Inverse() const;
+  // X with A * X = b, for one or many right-hand sides
+  S21BasicVector<T> Solve(const S21BasicVector<T>& b) const;
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T>& b) const;
+  // the same, overwriting b and allocating nothing
+  void SolveInPlace(S21BasicVector<T>& b) const;
+  void SolveInPlace(S21BasicMatrix<T>& b) const;
+
+  //=================   SUPPLEMENTARY   ======================
+  void CheckSolvable(int rows) const;
+
+ private:
+  S21BasicMatrix<T> factor_;
+};
+
+using S21Cholesky = S21BasicCholesky<double>;
+
+#endif  // S21_CHOLESKY_H
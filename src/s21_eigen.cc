@@ -0,0 +1,539 @@
+#include "s21_eigen.h"
+
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include "s21_gemm.h"
+#include "s21_simd.h"
+
+#define TMPL template <typename T>
+#define EIGEN S21BasicSymmetricEigen<T>
+// reflectors per panel, in the reduction and in the way back
+#define EIGEN_BLOCK 32
+// tridiagonals up to this size go to QL instead of being split
+#define EIGEN_LEAF 32
+// inverse iteration steps per eigenvector
+#define EIGEN_STEPS 3
+
+// The tridiagonal is (d, e): d[i] on the diagonal, e[i] coupling i and
+// i + 1. Eigenvectors of a tridiagonal are kept as rows.
+
+//=================   TRIDIAGONAL SOLVERS   ======================
+
+// x' = c * x + s * y, y' = c * y - s * x
+template <typename T>
+static void Rotate(int n, T *x, T *y, T c, T s) {
+  for (int k = 0; k < n; ++k) {
+    const T t = x[k];
+    x[k] = c * t + s * y[k], y[k] = c * y[k] - s * t;
+  }
+}
+
+// Implicit QL with Wilkinson shifts, as in EISPACK's tql2. Rows of the
+// n x n block at z, when given, take every rotation. e needs n entries,
+// the last one scratch.
+template <typename T>
+static void TridiagonalQL(int n, T *d, T *e, T *z, int ldz) {
+  const T eps = std::numeric_limits<T>::epsilon();
+  e[n - 1] = 0;
+  T norm = 0;
+  for (int l = 0; l < n; ++l) {
+    // off-diagonals split once negligible next to the rows seen so far
+    norm = std::max(norm, std::abs(d[l]) + std::abs(e[l]));
+    for (int iter = 0;; ++iter) {
+      int m = l;
+      while (m < n - 1 && !(std::abs(e[m]) <= eps * norm)) ++m;
+      if (m == l) break;
+      if (iter == 64) throw std::logic_error("Eigenvalues did not converge");
+      T g = (d[l + 1] - d[l]) / (2 * e[l]), r = std::hypot(g, T(1));
+      g = d[m] - d[l] + e[l] / (g + std::copysign(r, g));
+      T s = 1, c = 1, p = 0;
+      int i = m - 1;
+      for (; i >= l; --i) {
+        const T f = s * e[i], b = c * e[i];
+        e[i + 1] = r = std::hypot(f, g);
+        if (r == 0) break;
+        s = f / r, c = g / r, g = d[i + 1] - p;
+        r = (d[i] - g) * s + 2 * c * b;
+        d[i + 1] = g + (p = s * r);
+        g = c * r - b;
+        if (z) Rotate(n, z + i * ldz, z + (i + 1) * ldz, c, -s);
+      }
+      if (r == 0 && i >= l) {
+        d[i + 1] -= p, e[m] = 0;
+        continue;
+      }
+      d[l] -= p, e[l] = g, e[m] = 0;
+    }
+  }
+}
+
+// Root j of the secular equation 1 / rho + sum z[i]^2 / (d[i] - x) = 0,
+// d ascending and rho > 0, as x = d[origin] + tau. The origin is the pole
+// nearer the root, so every d[i] - x forms as (d[i] - d[origin]) - tau
+// without cancellation. Each step fits the poles either side of the root
+// to the current slopes and takes the zero of that model, falling back to
+// bisection when it leaves the bracket.
+template <typename T>
+static void SecularRoot(int k, int j, const T *d, const T *z, T rho,
+                        int &origin, T &tau) {
+  const T eps = std::numeric_limits<T>::epsilon();
+  const bool last = j == k - 1;
+  T lo = 0, hi;
+  origin = j;
+  if (last) {
+    hi = 0;
+    for (int i = 0; i < k; ++i) hi += z[i] * z[i];
+    hi *= rho;
+  } else {
+    hi = (d[j + 1] - d[j]) / 2;
+    T f = 1 / rho;
+    for (int i = 0; i < k; ++i) f += z[i] * z[i] / ((d[i] - d[j]) - hi);
+    if (f < 0) origin = j + 1, lo = -hi, hi = 0;
+  }
+  auto delta = [&](int i) { return (d[i] - d[origin]) - tau; };
+  tau = (lo + hi) / 2;
+  for (int iter = 0; iter < 100; ++iter) {
+    T psi = 0, dpsi = 0, phi = 0, dphi = 0;
+    for (int i = 0; i <= j; ++i) {
+      const T t = z[i] / delta(i);
+      psi += z[i] * t, dpsi += t * t;
+    }
+    for (int i = j + 1; i < k; ++i) {
+      const T t = z[i] / delta(i);
+      phi += z[i] * t, dphi += t * t;
+    }
+    const T f = 1 / rho + psi + phi;
+    if (std::abs(f) <= eps * (8 * (phi - psi) + 1 / rho +
+                              std::abs(tau) * (dpsi + dphi)))
+      return;
+    (f < 0 ? lo : hi) = tau;
+    if (hi - lo <= 2 * eps * std::max(std::abs(lo), std::abs(hi))) return;
+    // f(tau + s) ~ c + wa / (a - s) + wb / (b - s)
+    const T a = delta(j), wa = dpsi * a * a;
+    T step = std::numeric_limits<T>::quiet_NaN();
+    if (last) {
+      const T c = f - dpsi * a;
+      if (c < 0) step = a + wa / c;
+    } else {
+      const T b = delta(j + 1), wb = dphi * b * b, c = f - dpsi * a - dphi * b;
+      // c * s^2 - qb * s + qc = 0
+      const T qb = c * (a + b) + wa + wb, qc = c * a * b + wa * b + wb * a;
+      const T disc = qb * qb - 4 * c * qc;
+      if (c == 0) {
+        step = qc / qb;
+      } else if (disc >= 0) {
+        const T r = std::sqrt(disc), big = qb >= 0 ? qb + r : qb - r;
+        step = big / (2 * c);
+        if (!(tau + step > lo && tau + step < hi)) step = 2 * qc / big;
+      }
+    }
+    const T next = tau + step;
+    tau = next > lo && next < hi ? next : (lo + hi) / 2;
+  }
+}
+
+// d ascending, the rows of the n x n block at z following
+template <typename T>
+static void SortAscending(int n, T *d, T *z, int ldz) {
+  for (int i = 0; i < n; ++i) {
+    const int low = std::min_element(d + i, d + n) - d;
+    if (low == i) continue;
+    std::swap(d[i], d[low]);
+    std::swap_ranges(z + i * ldz, z + i * ldz + n, z + low * ldz);
+  }
+}
+
+// The halves' eigenpairs into those of the whole: the tridiagonal is
+// diag(T1, T2) + rho * u * u^T, and in the halves' eigenbasis the rank-one
+// term has weights w. Weights too small to matter, or pairs of poles too
+// close to tell apart after a rotation, deflate: their pairs stand as they
+// are. The rest solve the secular equation; the weights are recomputed
+// from its roots so that the new vectors come out orthogonal, and those
+// vectors take two Gemm passes, one per half of the columns, skipping the
+// rows of the other half which are zero there.
+template <typename T>
+static void Merge(int n, int h, T *d, T beta, T *z, int ldz) {
+  const T eps = std::numeric_limits<T>::epsilon();
+  const T rho = 2 * std::abs(beta), half = std::sqrt(T(0.5));
+  std::vector<T> w(n);
+  // 0 for rows zero in the second half, 2 in the first, 1 for dense rows
+  std::vector<char> kind(n);
+  T dmax = 0, wmax = 0;
+  for (int i = 0; i < n; ++i) {
+    w[i] = i < h ? half * z[i * ldz + h - 1]
+                 : std::copysign(half, beta) * z[i * ldz + h];
+    kind[i] = i < h ? 0 : 2;
+    dmax = std::max(dmax, std::abs(d[i]));
+    wmax = std::max(wmax, std::abs(w[i]));
+  }
+  std::vector<int> order(n), kept, deflated;
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [&](int x, int y) { return d[x] < d[y]; });
+  const T tol = 8 * eps * std::max(dmax, wmax);
+  int prev = -1;
+  for (int i : order) {
+    if (rho * std::abs(w[i]) <= tol) {
+      deflated.push_back(i);
+      continue;
+    }
+    if (prev >= 0) {
+      const T tau = std::hypot(w[prev], w[i]);
+      const T c = w[i] / tau, s = -w[prev] / tau;
+      if (std::abs((d[i] - d[prev]) * c * s) <= tol) {
+        w[i] = tau, w[prev] = 0;
+        Rotate(n, z + prev * ldz, z + i * ldz, c, s);
+        const T dp = d[prev] * c * c + d[i] * s * s;
+        d[i] = d[prev] * s * s + d[i] * c * c, d[prev] = dp;
+        if (kind[prev] != kind[i]) kind[prev] = kind[i] = 1;
+        deflated.push_back(prev);
+      } else {
+        kept.push_back(prev);
+      }
+    }
+    prev = i;
+  }
+  if (prev >= 0) kept.push_back(prev);
+
+  const int k = kept.size();
+  std::vector<T> dk(k), wk(k), taus(k), values(n), weights(k);
+  std::vector<int> origins(k), pos(k), next(3);
+  for (int i = 0; i < k; ++i) {
+    dk[i] = d[kept[i]], wk[i] = w[kept[i]];
+    ++next[kind[kept[i]]];
+  }
+  // rows only the first half, and then rows only the second, multiply
+  const int top = next[0] + next[1], bottom = next[1] + next[2];
+  const int dense = next[0];
+  for (int j = 0; j < k; ++j) {
+    SecularRoot(k, j, dk.data(), wk.data(), rho, origins[j], taus[j]);
+    values[j] = dk[origins[j]] + taus[j];
+  }
+  // k x k: u[j * k + i] = dk[i] - root j, then the new vectors in the basis
+  // of the kept rows, which rows holds grouped by kind; merged is n x n
+  std::vector<T> u(std::size_t(k) * k), rows(std::size_t(k) * n),
+      merged(std::size_t(n) * n);
+  for (int j = 0; j < k; ++j)
+    for (int i = 0; i < k; ++i)
+      u[j * k + i] = (dk[i] - dk[origins[j]]) - taus[j];
+  for (int i = 0; i < k; ++i) {
+    T product = -u[i * k + i] / rho;
+    for (int j = 0; j < k; ++j)
+      if (j != i) product *= u[j * k + i] / (dk[i] - dk[j]);
+    weights[i] = std::copysign(std::sqrt(product), wk[i]);
+  }
+  next = {0, next[0], top};
+  for (int i = 0; i < k; ++i) {
+    pos[i] = next[kind[kept[i]]]++;
+    std::copy_n(z + kept[i] * ldz, n, rows.data() + pos[i] * n);
+  }
+  std::vector<T> vector(k);
+  for (int j = 0; j < k; ++j) {
+    T *row = u.data() + j * k, norm = 0;
+    for (int i = 0; i < k; ++i)
+      vector[i] = weights[i] / row[i], norm += vector[i] * vector[i];
+    norm = 1 / std::sqrt(norm);
+    for (int i = 0; i < k; ++i) row[pos[i]] = vector[i] * norm;
+  }
+  S21Gemm(k, h, top, u.data(), k, rows.data(), n, merged.data(), n);
+  S21Gemm(k, n - h, bottom, u.data() + dense, k,
+          rows.data() + std::size_t(dense) * n + h, n, merged.data() + h, n);
+  for (int i = k; i < n; ++i) {
+    values[i] = d[deflated[i - k]];
+    std::copy_n(z + deflated[i - k] * ldz, n, merged.data() + i * n);
+  }
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [&](int x, int y) { return values[x] < values[y]; });
+  for (int i = 0; i < n; ++i) {
+    d[i] = values[order[i]];
+    std::copy_n(merged.data() + order[i] * n, n, z + i * ldz);
+  }
+}
+
+// Eigenpairs of the tridiagonal into d, ascending, and the rows of the
+// n x n block at z, zero on entry. e[n - 1] is scratch.
+template <typename T>
+static void DivideConquer(int n, T *d, T *e, T *z, int ldz) {
+  if (n <= EIGEN_LEAF) {
+    for (int i = 0; i < n; ++i) z[i * ldz + i] = 1;
+    TridiagonalQL(n, d, e, z, ldz);
+    return SortAscending(n, d, z, ldz);
+  }
+  // diag(T1, T2) + |beta| * u * u^T, u = e(h - 1) + sign(beta) * e(h)
+  const int h = n / 2;
+  const T beta = e[h - 1];
+  d[h - 1] -= std::abs(beta), d[h] -= std::abs(beta);
+  DivideConquer(h, d, e, z, ldz);
+  DivideConquer(n - h, d + h, e + h, z + h * ldz + h, ldz);
+  Merge(n, h, d, beta, z, ldz);
+}
+
+// eigenvalues below x: the negative pivots of the LDL^T of T - x
+template <typename T>
+static int CountBelow(int n, const T *d, const T *e, T x, T pivmin) {
+  int count = 0;
+  T q = 1;
+  for (int i = 0; i < n; ++i) {
+    q = d[i] - x - (i ? e[i - 1] * e[i - 1] / q : 0);
+    if (std::abs(q) < pivmin) q = -pivmin;
+    count += q < 0;
+  }
+  return count;
+}
+
+// the count largest eigenvalues, largest first, by bisection on the
+// Gershgorin interval
+template <typename T>
+static void Bisection(int n, const T *d, const T *e, int count, T *values) {
+  const T eps = std::numeric_limits<T>::epsilon();
+  T low = d[0], high = d[0], pivmin = 1;
+  for (int i = 0; i < n; ++i) {
+    const T radius = (i ? std::abs(e[i - 1]) : 0) +
+                     (i + 1 < n ? std::abs(e[i]) : 0);
+    low = std::min(low, d[i] - radius), high = std::max(high, d[i] + radius);
+    if (i + 1 < n) pivmin = std::max(pivmin, e[i] * e[i]);
+  }
+  pivmin *= std::numeric_limits<T>::min();
+  const T slack = 2 * eps * n * std::max(std::abs(low), std::abs(high));
+  low -= slack + 2 * pivmin, high += slack + 2 * pivmin;
+  for (int j = 0; j < count; ++j) {
+    T lo = low, hi = j ? values[j - 1] + slack : high;
+    // the eigenvalue with n - 1 - j below it
+    while (hi - lo > 2 * eps * std::max(std::abs(lo), std::abs(hi)) + pivmin) {
+      const T mid = (lo + hi) / 2;
+      (CountBelow(n, d, e, mid, pivmin) > n - 1 - j ? hi : lo) = mid;
+    }
+    values[j] = (lo + hi) / 2;
+  }
+}
+
+// Unit eigenvectors of the tridiagonal for the given eigenvalues, largest
+// first, into the rows of z: a few steps of inverse iteration each, from a
+// fixed pseudo-random start, orthogonalized against the vectors of the
+// same cluster. T - x factors with partial pivoting into a unit lower
+// bidiagonal L and an upper U with two superdiagonals.
+template <typename T>
+static void InverseIteration(int n, const T *d, const T *e, int count,
+                             const T *values, T *z, int ldz) {
+  const S21Kernels<T> &kernels = S21GetKernels<T>();
+  const T eps = std::numeric_limits<T>::epsilon();
+  T norm = 0;
+  for (int i = 0; i < n; ++i)
+    norm = std::max(norm, std::abs(d[i]) + (i ? std::abs(e[i - 1]) : 0) +
+                              (i + 1 < n ? std::abs(e[i]) : 0));
+  const T cluster = T(1e-3) * norm, pertol = 10 * eps * norm;
+  const T tiny = std::max(eps * norm, std::numeric_limits<T>::min());
+  std::vector<T> u0(n), u1(n), u2(n), l(n);
+  std::vector<char> swapped(n);
+  std::uint32_t seed = 1;
+  int first = 0;
+  T shift = 0;
+  for (int j = 0; j < count; ++j) {
+    if (j && values[j - 1] - values[j] > cluster) first = j;
+    // equal values in a cluster get apart shifts
+    shift = j > first ? std::min(values[j], shift - pertol) : values[j];
+    T a = d[0] - shift, b = n > 1 ? e[0] : 0;
+    for (int i = 0; i + 1 < n; ++i) {
+      const T sub = e[i], diag = d[i + 1] - shift;
+      const T super = i + 2 < n ? e[i + 1] : 0;
+      swapped[i] = std::abs(a) < std::abs(sub);
+      if (!swapped[i]) {
+        if (std::abs(a) < tiny) a = std::copysign(tiny, a);
+        l[i] = sub / a, u0[i] = a, u1[i] = b, u2[i] = 0;
+        a = diag - l[i] * b, b = super;
+      } else {
+        l[i] = a / sub, u0[i] = sub, u1[i] = diag, u2[i] = super;
+        a = b - l[i] * diag, b = -l[i] * super;
+      }
+    }
+    u0[n - 1] = std::abs(a) < tiny ? std::copysign(tiny, a) : a;
+    T *v = z + std::ptrdiff_t(j) * ldz;
+    for (int i = 0; i < n; ++i) {
+      seed = seed * 1664525u + 1013904223u;
+      v[i] = T(seed >> 8) / T(1 << 24) - T(0.5);
+    }
+    for (int step = 0; step < EIGEN_STEPS; ++step) {
+      for (int i = 0; i + 1 < n; ++i) {
+        if (swapped[i]) std::swap(v[i], v[i + 1]);
+        v[i + 1] -= l[i] * v[i];
+      }
+      for (int i = n - 1; i >= 0; --i)
+        v[i] = (v[i] - (i + 1 < n ? u1[i] * v[i + 1] : 0) -
+                (i + 2 < n ? u2[i] * v[i + 2] : 0)) /
+               u0[i];
+      for (int p = first; p < j; ++p) {
+        const T *other = z + std::ptrdiff_t(p) * ldz;
+        kernels.axpy(n, v, other, -kernels.dot(n, v, other));
+      }
+      kernels.scale(n, v, 1 / std::sqrt(kernels.dot(n, v, v)));
+    }
+  }
+}
+
+//=================  CONSTRUCTORS   ======================
+
+TMPL EIGEN::S21BasicSymmetricEigen(const S21BasicMatrix<T> &matrix, int count,
+                                   bool vectors)
+    : size_(matrix.GetRows()) {
+  matrix.CheckSquare();
+  const int n = size_;
+  if (count < 1 || count > n)
+    throw std::invalid_argument("Invalid number of eigenvalues");
+  values_ = S21BasicVector<T>(count);
+  // the upper triangle of A^T is the lower one of A
+  S21BasicMatrix<T> a = matrix.Transpose();
+  std::vector<T> d(n), e(n), taus(n);
+  Tridiagonalize(a, d.data(), e.data(), taus.data());
+  T *values = values_.Data();
+  if (count < n) {
+    Bisection(n, d.data(), e.data(), count, values);
+  } else if (!vectors) {
+    TridiagonalQL(n, d.data(), e.data(), static_cast<T *>(nullptr), 0);
+    std::sort(d.begin(), d.end());
+    std::reverse_copy(d.begin(), d.end(), values);
+  }
+  if (!vectors) return;
+  S21BasicMatrix<T> z(count, n);
+  if (count < n) {
+    InverseIteration(n, d.data(), e.data(), count, values, z.matrix_,
+                     z.stride_);
+  } else {
+    DivideConquer(n, d.data(), e.data(), z.matrix_, z.stride_);
+    std::reverse_copy(d.begin(), d.end(), values);
+    for (int i = 0; i < n / 2; ++i)
+      std::swap_ranges(z.RowPtr(i), z.RowPtr(i) + n, z.RowPtr(n - 1 - i));
+  }
+  BackTransform(a, taus.data(), z);
+  vectors_ = z.Transpose();
+}
+
+//=================   SUPPLEMENTARY   ======================
+
+// Q^T * A * Q = tridiagonal, Q = H(0) * ... * H(n - 2), on the upper
+// triangle of a. Reflector j zeroes row j past column j + 1 and is kept in
+// row j from column j + 1 on, its leading 1 included. Within a panel row j
+// takes the earlier reflectors' two-sided updates A -= V * W^T + W * V^T
+// from V and W directly, and W's next row comes from one pass over the
+// trailing upper triangle; the trailing matrix then takes the whole panel
+// through S21Gemm, one block row at a time.
+TMPL void EIGEN::Tridiagonalize(S21BasicMatrix<T> &a, T *d, T *e, T *taus) {
+  const S21Kernels<T> &kernels = S21GetKernels<T>();
+  const int n = a.rows_;
+  // W^T of the panel, and -V and -W for the Gemm lhs
+  S21BasicMatrix<T> wt(EIGEN_BLOCK, n), v(n, EIGEN_BLOCK), w(n, EIGEN_BLOCK);
+  for (int k0 = 0; k0 + 1 < n; k0 += EIGEN_BLOCK) {
+    const int end = std::min(k0 + EIGEN_BLOCK, n - 1), nb = end - k0;
+    std::fill_n(wt.matrix_, std::size_t(nb) * wt.stride_, T());
+    for (int j = k0; j < end; ++j) {
+      const int p = j - k0, len = n - j - 1;
+      T *row = a.RowPtr(j), *y = wt.RowPtr(p) + j + 1;
+      for (int q = 0; q < p; ++q) {
+        const T *vq = a.RowPtr(k0 + q), *wq = wt.RowPtr(q);
+        kernels.axpy(n - j, row + j, wq + j, -vq[j]);
+        kernels.axpy(n - j, row + j, vq + j, -wq[j]);
+      }
+      d[j] = row[j];
+      const T alpha = row[j + 1];
+      const T sigma = kernels.dot(len - 1, row + j + 2, row + j + 2);
+      T tau = 0, beta = alpha;
+      if (sigma != 0) {
+        beta = -std::copysign(std::sqrt(alpha * alpha + sigma), alpha);
+        tau = (beta - alpha) / beta;
+        kernels.scale(len - 1, row + j + 2, 1 / (alpha - beta));
+      }
+      e[j] = beta, taus[j] = tau, row[j + 1] = 1;
+      if (tau == 0) continue;
+      // y = tau * (A - V * W^T - W * V^T) * v over rows and columns past j
+      const T *x = row + j + 1;
+      for (int i = j + 1; i < n; ++i) {
+        const T *r = a.RowPtr(i) + i, xi = x[i - j - 1];
+        y[i - j - 1] += r[0] * xi + kernels.dot(n - i - 1, r + 1, x + i - j);
+        kernels.axpy(n - i - 1, y + i - j, r + 1, xi);
+      }
+      for (int q = 0; q < p; ++q) {
+        const T *vq = a.RowPtr(k0 + q) + j + 1, *wq = wt.RowPtr(q) + j + 1;
+        const T vw = kernels.dot(len, wq, x), vv = kernels.dot(len, vq, x);
+        kernels.axpy(len, y, vq, -vw);
+        kernels.axpy(len, y, wq, -vv);
+      }
+      kernels.scale(len, y, tau);
+      kernels.axpy(len, y, x, -tau / 2 * kernels.dot(len, y, x));
+    }
+    // A22 -= V * W^T + W * V^T on and above the diagonal blocks
+    const int m = n - end;
+    kernels.transpose(nb, m, a.RowPtr(k0) + end, a.stride_, v.matrix_,
+                      v.stride_);
+    kernels.transpose(nb, m, wt.matrix_ + end, wt.stride_, w.matrix_,
+                      w.stride_);
+    FOR(m) {
+      kernels.scale(nb, v.RowPtr(i), -1);
+      kernels.scale(nb, w.RowPtr(i), -1);
+    }
+    for (int r0 = end; r0 < n; r0 += EIGEN_BLOCK) {
+      const int rows = std::min(EIGEN_BLOCK, n - r0);
+      T *c = a.RowPtr(r0) + r0;
+      S21Gemm(rows, n - r0, nb, v.RowPtr(r0 - end), v.stride_,
+              wt.matrix_ + r0, wt.stride_, c, a.stride_);
+      S21Gemm(rows, n - r0, nb, w.RowPtr(r0 - end), w.stride_,
+              a.RowPtr(k0) + r0, a.stride_, c, a.stride_);
+    }
+  }
+  d[n - 1] = a.RowPtr(n - 1)[n - 1];
+}
+
+// Rows of z, eigenvectors of the tridiagonal, into eigenvectors of A:
+// z <- z * Q^T, the last panel first. A panel is H(k0) * ... * H(end - 1)
+// = I - V * T * V^T with T upper triangular from V^T * V, so it applies
+// as z -= ((z * V) * T^T) * V^T in two Gemm passes.
+TMPL void EIGEN::BackTransform(const S21BasicMatrix<T> &a, const T *taus,
+                               S21BasicMatrix<T> &z) {
+  const S21Kernels<T> &kernels = S21GetKernels<T>();
+  const int n = a.rows_, c = z.rows_;
+  if (n < 2) return;
+  S21BasicMatrix<T> vt(EIGEN_BLOCK, n), v(n, EIGEN_BLOCK),
+      t(EIGEN_BLOCK, EIGEN_BLOCK), w(c, EIGEN_BLOCK);
+  for (int k0 = (n - 2) / EIGEN_BLOCK * EIGEN_BLOCK; k0 >= 0;
+       k0 -= EIGEN_BLOCK) {
+    const int end = std::min(k0 + EIGEN_BLOCK, n - 1), nb = end - k0;
+    const int s = k0 + 1, m = n - s;
+    // V^T over columns s .., zero before each leading 1
+    for (int q = 0; q < nb; ++q) {
+      std::fill_n(vt.RowPtr(q), q, T());
+      std::copy(a.RowPtr(k0 + q) + s + q, a.RowPtr(k0 + q) + n,
+                vt.RowPtr(q) + q);
+    }
+    for (int j = 0; j < nb; ++j) {
+      T gram[EIGEN_BLOCK];
+      for (int q = 0; q < j; ++q)
+        gram[q] = kernels.dot(m - j, vt.RowPtr(q) + j, vt.RowPtr(j) + j);
+      t.RowPtr(j)[j] = taus[k0 + j];
+      for (int p = 0; p < j; ++p) {
+        T sum = 0;
+        for (int q = p; q < j; ++q) sum += t.RowPtr(p)[q] * gram[q];
+        t.RowPtr(p)[j] = -taus[k0 + j] * sum;
+      }
+    }
+    kernels.transpose(nb, m, vt.matrix_, vt.stride_, v.matrix_, v.stride_);
+    std::fill_n(w.matrix_, std::size_t(c) * w.stride_, T());
+    S21Gemm(c, nb, m, z.matrix_ + s, z.stride_, v.matrix_, v.stride_,
+            w.matrix_, w.stride_);
+    // W = -W * T^T, column q reading W's columns from q on
+    FOR(c) {
+      T *x = w.RowPtr(i);
+      for (int q = 0; q < nb; ++q) {
+        T sum = 0;
+        for (int p = q; p < nb; ++p) sum += t.RowPtr(q)[p] * x[p];
+        x[q] = -sum;
+      }
+    }
+    S21Gemm(c, m, nb, w.matrix_, w.stride_, vt.matrix_, vt.stride_,
+            z.matrix_ + s, z.stride_);
+  }
+}
+
+#define INSTANTIATE(T) template class S21BasicSymmetricEigen<T>;
+S21_REAL_TYPES(INSTANTIATE)
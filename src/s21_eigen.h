@@ -0,0 +1,55 @@
+#ifndef S21_EIGEN_H
+#define S21_EIGEN_H
+
+#include "s21_matrix_oop.h"
+
+//=================   SYMMETRIC EIGENPROBLEM   ======================
+// A = V * diag(values) * V^T for symmetric A, of which only the lower
+// triangle is read. Householder reflectors in EIGEN_BLOCK panels reduce A
+// to a tridiagonal, half of that work going through S21Gemm. Divide and
+// conquer then finds all of its eigenpairs, merging halves through the
+// secular equation and S21Gemm, and the reflectors carry the vectors back
+// a panel at a time. Eigenvalues alone skip both vector passes and take
+// implicit QL on the tridiagonal; the largest few go by bisection and
+// inverse iteration, so only their vectors are carried back. For the
+// types in S21_REAL_TYPES.
+
+template <typename T>
+class S21BasicSymmetricEigen {
+  static_assert(std::is_floating_point_v<T>, "Real symmetric matrices only");
+
+ public:
+  using Scalar = T;
+
+  //=================  CONSTRUCTORS   ======================
+  // every eigenvalue, and its eigenvector unless vectors is false
+  explicit S21BasicSymmetricEigen(const S21BasicMatrix<T>& matrix,
+                                  bool vectors = true)
+      : S21BasicSymmetricEigen(matrix, matrix.GetRows(), vectors) {}
+  // the count largest eigenvalues, and their eigenvectors unless vectors
+  // is false
+  S21BasicSymmetricEigen(const S21BasicMatrix<T>& matrix, int count,
+                         bool vectors = true);
+
+  //=================   GET   ======================
+  int GetSize() const { return size_; }
+  int GetCount() const { return values_.GetSize(); }
+  // largest first
+  const S21BasicVector<T>& GetValues() const { return values_; }
+  // GetSize() x GetCount(), column j the unit eigenvector of value j;
+  // empty when the vectors were not asked for
+  const S21BasicMatrix<T>& GetVectors() const { return vectors_; }
+
+ private:
+  static void Tridiagonalize(S21BasicMatrix<T>& a, T* d, T* e, T* taus);
+  static void BackTransform(const S21BasicMatrix<T>& a, const T* taus,
+                            S21BasicMatrix<T>& z);
+
+  int size_;
+  S21BasicVector<T> values_;
+  S21BasicMatrix<T> vectors_;
+};
+
+using S21SymmetricEigen = S21BasicSymmetricEigen<double>;
+
+#endif  // S21_EIGEN_H
@@ -0,0 +1,235 @@
+#ifndef S21_FIXED_MATRIX_H
+#define S21_FIXED_MATRIX_H
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "s21_matrix_oop.h"
+
+//=================   FIXED-SIZE MATRICES   ======================
+// Sizes are template arguments: the elements live inside the object, shape
+// mismatches fail to compile instead of reaching CheckSizes, and products
+// are unrolled into straight-line code. Determinant, complements and the
+// inverse are closed-form cofactor expansions up to 4x4; larger sizes go
+// through S21Matrix and are not constexpr.
+
+template <int R, int C>
+class S21FixedMatrix {
+  static_assert(R > 0 && C > 0, "Sizes must be positive");
+
+ public:
+  //=================  CONSTRUCTORS   ======================
+  constexpr S21FixedMatrix() : data_{} {}
+  // row by row, exactly R * C values
+  template <typename... T,
+            typename = std::enable_if_t<sizeof...(T) == R * C &&
+                                        (std::is_arithmetic_v<T> && ...)>>
+  constexpr S21FixedMatrix(T... values) : data_{double(values)...} {}
+  explicit S21FixedMatrix(const S21Matrix& other) : data_{} {
+    if (other.rows_ != R || other.cols_ != C)
+      throw std::invalid_argument("Unequal size of matrices");
+    FORJ(R, C) data_[i][j] = other.RowPtr(i)[j];
+  }
+  operator S21Matrix() const {
+    S21Matrix result(R, C);
+    FORJ(R, C) result.RowPtr(i)[j] = data_[i][j];
+    return result;
+  }
+
+  //=================   GET   ======================
+  static constexpr int GetRows() { return R; }
+  static constexpr int GetCols() { return C; }
+
+  //=================   ARITHMETIC   ======================
+  constexpr bool EqMatrix(const S21FixedMatrix& other) const {
+    FORJ(R, C)
+    if (Abs(data_[i][j] - other.data_[i][j]) >= S21Traits<double>::kEps)
+      return false;
+    return true;
+  }
+  constexpr void SumMatrix(const S21FixedMatrix& other) {
+    FORJ(R, C) data_[i][j] += other.data_[i][j];
+  }
+  constexpr void SubMatrix(const S21FixedMatrix& other) {
+    FORJ(R, C) data_[i][j] -= other.data_[i][j];
+  }
+  constexpr void MulNumber(const double num) {
+    FORJ(R, C) data_[i][j] *= num;
+  }
+  constexpr void MulMatrix(const S21FixedMatrix<C, C>& other) {
+    *this = Product(*this, other);
+  }
+
+  //=================   OPERATIONS   ======================
+  constexpr double Determinant() const;
+  constexpr S21FixedMatrix<C, R> Transpose() const;
+  constexpr S21FixedMatrix CalcComplements() const;
+  constexpr S21FixedMatrix InverseMatrix() const;
+
+  //=================   OPERATOR OVERLOAD   ======================
+  // unchecked: the indices of fixed-size code are known to be in range
+  constexpr double& operator()(int row, int col) { return data_[row][col]; }
+  constexpr double operator()(int row, int col) const {
+    return data_[row][col];
+  }
+  constexpr bool operator==(const S21FixedMatrix& other) const {
+    return EqMatrix(other);
+  }
+  constexpr S21FixedMatrix& operator+=(const S21FixedMatrix& other) {
+    return SumMatrix(other), *this;
+  }
+  constexpr S21FixedMatrix& operator-=(const S21FixedMatrix& other) {
+    return SubMatrix(other), *this;
+  }
+  constexpr S21FixedMatrix& operator*=(const S21FixedMatrix<C, C>& other) {
+    return MulMatrix(other), *this;
+  }
+  constexpr S21FixedMatrix& operator*=(const double mul) {
+    return MulNumber(mul), *this;
+  }
+
+  //=================   SUPPLEMENTARY   ======================
+  constexpr S21FixedMatrix<R - 1, C - 1> Minor(int row, int col) const;
+  template <int K>
+  static constexpr S21FixedMatrix Product(const S21FixedMatrix<R, K>& lhs,
+                                          const S21FixedMatrix<K, C>& rhs) {
+    return Unrolled(lhs, rhs, std::make_integer_sequence<int, R * C>(),
+                    std::make_integer_sequence<int, K>());
+  }
+
+ private:
+  template <int, int>
+  friend class S21FixedMatrix;
+
+  static constexpr double Abs(double x) { return x < 0 ? -x : x; }
+
+  // one assignment per element, each a K-term sum in the loop's order
+  template <int K, int... I, int... P>
+  static constexpr S21FixedMatrix Unrolled(
+      const S21FixedMatrix<R, K>& lhs, const S21FixedMatrix<K, C>& rhs,
+      std::integer_sequence<int, I...>, std::integer_sequence<int, P...> p) {
+    S21FixedMatrix result;
+    ((result.data_[I / C][I % C] = Dot(lhs.data_[I / C], rhs, I % C, p)), ...);
+    return result;
+  }
+  template <int K, int... P>
+  static constexpr double Dot(const double (&row)[K],
+                              const S21FixedMatrix<K, C>& rhs, int col,
+                              std::integer_sequence<int, P...>) {
+    return (0.0 + ... + (row[P] * rhs.data_[P][col]));
+  }
+
+  double data_[R][C];
+};
+
+//=================   OPERATORS   ======================
+
+template <int R, int C>
+constexpr S21FixedMatrix<R, C> operator+(S21FixedMatrix<R, C> lhs,
+                                         const S21FixedMatrix<R, C>& rhs) {
+  return lhs += rhs;
+}
+
+template <int R, int C>
+constexpr S21FixedMatrix<R, C> operator-(S21FixedMatrix<R, C> lhs,
+                                         const S21FixedMatrix<R, C>& rhs) {
+  return lhs -= rhs;
+}
+
+template <int R, int C>
+constexpr S21FixedMatrix<R, C> operator*(S21FixedMatrix<R, C> lhs,
+                                         double num) {
+  return lhs *= num;
+}
+
+template <int R, int C>
+constexpr S21FixedMatrix<R, C> operator*(double num,
+                                         S21FixedMatrix<R, C> rhs) {
+  return rhs *= num;
+}
+
+template <int R, int K, int C>
+constexpr S21FixedMatrix<R, C> operator*(const S21FixedMatrix<R, K>& lhs,
+                                         const S21FixedMatrix<K, C>& rhs) {
+  return S21FixedMatrix<R, C>::Product(lhs, rhs);
+}
+
+//=================   OPERATIONS   ======================
+
+template <int R, int C>
+constexpr double S21FixedMatrix<R, C>::Determinant() const {
+  static_assert(R == C, "Matrix is not square");
+  if constexpr (R == 1) {
+    return data_[0][0];
+  } else if constexpr (R == 2) {
+    return data_[0][0] * data_[1][1] - data_[0][1] * data_[1][0];
+  } else if constexpr (R <= 4) {
+    // along the first row, as S21Matrix does for 3x3
+    double det = 0, sign = 1;
+    for (int j = 0; j < C; ++j, sign = -sign)
+      det += sign * data_[0][j] * Minor(0, j).Determinant();
+    return det;
+  } else {
+    return S21Matrix(*this).Determinant();
+  }
+}
+
+template <int R, int C>
+constexpr S21FixedMatrix<C, R> S21FixedMatrix<R, C>::Transpose() const {
+  S21FixedMatrix<C, R> result;
+  FORJ(R, C) result.data_[j][i] = data_[i][j];
+  return result;
+}
+
+template <int R, int C>
+constexpr S21FixedMatrix<R, C> S21FixedMatrix<R, C>::CalcComplements() const {
+  static_assert(R == C, "Matrix is not square");
+  static_assert(R > 1, "Size can not be 1");
+  if constexpr (R <= 4) {
+    S21FixedMatrix result;
+    FORJ(R, C)
+    result.data_[i][j] = ((i + j) % 2 ? -1 : 1) * Minor(i, j).Determinant();
+    return result;
+  } else {
+    return S21FixedMatrix(S21Matrix(*this).CalcComplements());
+  }
+}
+
+template <int R, int C>
+constexpr S21FixedMatrix<R, C> S21FixedMatrix<R, C>::InverseMatrix() const {
+  static_assert(R == C, "Matrix is not square");
+  if constexpr (R <= 4) {
+    const double det = Determinant();
+    // rounding noise next to largest^R, the product of R pivots each at
+    // the S21NegligiblePivot bound, so 1e-3 * I still inverts
+    double largest = 0, noise = R * std::numeric_limits<double>::epsilon();
+    FORJ(R, C) largest = std::max(largest, Abs(data_[i][j]));
+    FOR(R) noise *= largest;
+    if (Abs(det) <= noise) throw std::logic_error("Determinant cannot be 0");
+    S21FixedMatrix result;
+    if constexpr (R == 1)
+      result.data_[0][0] = 1;
+    else
+      result = CalcComplements().Transpose();
+    FORJ(R, C) result.data_[i][j] /= det;
+    return result;
+  } else {
+    return S21FixedMatrix(S21Matrix(*this).InverseMatrix());
+  }
+}
+
+//=================   SUPPLEMENTARY   ======================
+
+template <int R, int C>
+constexpr S21FixedMatrix<R - 1, C - 1> S21FixedMatrix<R, C>::Minor(
+    int row, int col) const {
+  S21FixedMatrix<R - 1, C - 1> minor;
+  FORJ(R - 1, C - 1)
+  minor.data_[i][j] = data_[i + (i >= row)][j + (j >= col)];
+  return minor;
+}
+
+#endif  // S21_FIXED_MATRIX_H
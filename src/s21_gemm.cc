@@ -0,0 +1,261 @@
+#include "s21_gemm.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "s21_thread_pool.h"
+#include "s21_traits.h"
+
+// GEMM_NR doubles worth of T per micro-tile row
+template <typename T>
+static constexpr int kNr = GEMM_NR * int(sizeof(double)) / int(sizeof(T));
+
+//=================   PACKING   ======================
+
+template <typename T>
+struct PackBuffer {
+  explicit PackBuffer(std::size_t size)
+      : data(static_cast<T*>(
+            ::operator new(size * sizeof(T), std::align_val_t(64)))) {}
+  ~PackBuffer() { ::operator delete(data, std::align_val_t(64)); }
+  PackBuffer(const PackBuffer&) = delete;
+  PackBuffer& operator=(const PackBuffer&) = delete;
+  T* data;
+};
+
+// mc x kc block of A as MR-row micro-panels, column by column, zero-padded
+template <typename T>
+static void PackA(int mc, int kc, const T* a, int lda, T* dst) {
+  for (int ir = 0; ir < mc; ir += GEMM_MR) {
+    const int mr = std::min(GEMM_MR, mc - ir);
+    for (int p = 0; p < kc; ++p, dst += GEMM_MR) {
+      for (int r = 0; r < mr; ++r) dst[r] = a[(ir + r) * lda + p];
+      for (int r = mr; r < GEMM_MR; ++r) dst[r] = 0;
+    }
+  }
+}
+
+// kc x nc panel of B as NR-column micro-panels, row by row, zero-padded
+template <typename T>
+static void PackB(int kc, int nc, const T* b, int ldb, T* dst) {
+  for (int jr = 0; jr < nc; jr += kNr<T>) {
+    const int nr = std::min(kNr<T>, nc - jr);
+    for (int p = 0; p < kc; ++p, dst += kNr<T>) {
+      const T* src = b + p * ldb + jr;
+      for (int j = 0; j < nr; ++j) dst[j] = src[j];
+      for (int j = nr; j < kNr<T>; ++j) dst[j] = 0;
+    }
+  }
+}
+
+//=================   MICRO-KERNEL   ======================
+
+template <typename T>
+static void MicroKernel(int kc, const T* a, const T* b, T* c, int ldc, int mr,
+                        int nr) {
+  T acc[GEMM_MR][kNr<T>] = {};
+  if constexpr (std::is_arithmetic_v<T>) {
+    // one NR-wide vector per tile row keeps GCC from vectorizing across rows
+    typedef T Row __attribute__((vector_size(sizeof(T) * kNr<T>)));
+    Row rows[GEMM_MR] = {};
+    for (int p = 0; p < kc; ++p, a += GEMM_MR, b += kNr<T>) {
+      Row panel;
+      std::memcpy(&panel, b, sizeof(panel));
+      for (int i = 0; i < GEMM_MR; ++i) rows[i] += a[i] * panel;
+    }
+    std::memcpy(acc, rows, sizeof(acc));
+  } else {
+    for (int p = 0; p < kc; ++p, a += GEMM_MR, b += kNr<T>)
+      for (int i = 0; i < GEMM_MR; ++i)
+        for (int j = 0; j < kNr<T>; ++j) acc[i][j] += a[i] * b[j];
+  }
+  for (int i = 0; i < mr; ++i)
+    for (int j = 0; j < nr; ++j) c[i * ldc + j] += acc[i][j];
+}
+
+//=================   DRIVER   ======================
+
+// products below this many multiply-adds are not worth packing
+#define GEMM_SMALL (64 * 64 * 64)
+
+template <typename T>
+static void SmallGemm(int m, int n, int k, const T* a, int lda, const T* b,
+                      int ldb, T* c, int ldc) {
+  for (int i = 0; i < m; ++i)
+    for (int p = 0; p < k; ++p) {
+      const T x = a[i * lda + p], *row = b + p * ldb;
+      T* dst = c + i * ldc;
+      for (int j = 0; j < n; ++j) dst[j] += x * row[j];
+    }
+}
+
+template <typename T>
+static void PackedGemm(int m, int n, int k, const T* a, int lda, const T* b,
+                       int ldb, T* c, int ldc) {
+  const int kcMax = std::min(k, GEMM_KC), mcMax = std::min(m, GEMM_MC);
+  const int ncMax = std::min(n, GEMM_NC);
+  PackBuffer<T> packA(std::size_t(kcMax) * (mcMax + GEMM_MR));
+  PackBuffer<T> packB(std::size_t(kcMax) * (ncMax + kNr<T>));
+
+  for (int jc = 0; jc < n; jc += GEMM_NC) {
+    const int nc = std::min(GEMM_NC, n - jc);
+    for (int pc = 0; pc < k; pc += GEMM_KC) {
+      const int kc = std::min(GEMM_KC, k - pc);
+      PackB(kc, nc, b + std::ptrdiff_t(pc) * ldb + jc, ldb, packB.data);
+      for (int ic = 0; ic < m; ic += GEMM_MC) {
+        const int mc = std::min(GEMM_MC, m - ic);
+        PackA(mc, kc, a + std::ptrdiff_t(ic) * lda + pc, lda, packA.data);
+        for (int jr = 0; jr < nc; jr += kNr<T>)
+          for (int ir = 0; ir < mc; ir += GEMM_MR)
+            MicroKernel(kc, packA.data + ir * kc, packB.data + jr * kc,
+                        c + std::ptrdiff_t(ic + ir) * ldc + jc + jr, ldc,
+                        std::min(GEMM_MR, mc - ir), std::min(kNr<T>, nc - jr));
+      }
+    }
+  }
+}
+
+// Threads own disjoint MC-row blocks of C, or GEMM_SLICE-column slices when
+// there are too few row blocks to go around; each packs its own panels.
+template <typename T>
+static void ClassicalGemm(int m, int n, int k, const T* a, int lda, const T* b,
+                          int ldb, T* c, int ldc) {
+  if (m < 1 || n < 1 || k < 1) return;
+  if (double(m) * n * k <= GEMM_SMALL)
+    return SmallGemm(m, n, k, a, lda, b, ldb, c, ldc);
+
+  S21ThreadPool& pool = S21ThreadPool::Instance();
+  const int rowBlocks = (m + GEMM_MC - 1) / GEMM_MC;
+  const int colBlocks = (n + GEMM_SLICE - 1) / GEMM_SLICE;
+  if (rowBlocks >= S21Parallelism::Current() || rowBlocks >= colBlocks) {
+    auto rows = [&](int from, int to) {
+      const int i0 = from * GEMM_MC, i1 = std::min(m, to * GEMM_MC);
+      PackedGemm(i1 - i0, n, k, a + std::ptrdiff_t(i0) * lda, lda, b, ldb,
+                 c + std::ptrdiff_t(i0) * ldc, ldc);
+    };
+    pool.ParallelFor(0, rowBlocks, 1, rows);
+  } else {
+    auto cols = [&](int from, int to) {
+      const int j0 = from * GEMM_SLICE, j1 = std::min(n, to * GEMM_SLICE);
+      PackedGemm(m, j1 - j0, k, a, lda, b + j0, ldb, c + j0, ldc);
+    };
+    pool.ParallelFor(0, colBlocks, 1, cols);
+  }
+}
+
+//=================   STRASSEN-WINOGRAD   ======================
+
+static std::atomic<int> strassenCrossover{GEMM_STRASSEN};
+static thread_local int tNoStrassen = 0;
+
+int S21GetStrassenCrossover() { return strassenCrossover; }
+void S21SetStrassenCrossover(int size) { strassenCrossover = size; }
+
+S21NoStrassen::S21NoStrassen() { ++tNoStrassen; }
+S21NoStrassen::~S21NoStrassen() { --tNoStrassen; }
+
+static bool Splits(int m, int n, int k, int crossover) {
+  return crossover > 0 && std::min({m, n, k}) >= std::max(crossover, 2);
+}
+
+// scratch for S, T and P at this level and every level below it
+static std::size_t StrassenScratch(int m, int n, int k, int crossover) {
+  if (!Splits(m, n, k, crossover)) return 0;
+  const std::size_t hm = m / 2, hn = n / 2, hk = k / 2;
+  return hm * hk + hk * hn + hm * hn +
+         StrassenScratch(hm, hn, hk, crossover);
+}
+
+// dst = x + y, or x - y for a negative sign, over an m x n block
+template <typename T>
+static void Combine(int m, int n, T* dst, int ldd, const T* x, int ldx,
+                    const T* y, int ldy, int sign) {
+  auto rows = [&](int from, int to) {
+    for (int i = from; i < to; ++i) {
+      T* d = dst + std::ptrdiff_t(i) * ldd;
+      const T *u = x + std::ptrdiff_t(i) * ldx,
+              *v = y + std::ptrdiff_t(i) * ldy;
+      if (sign < 0)
+        for (int j = 0; j < n; ++j) d[j] = u[j] - v[j];
+      else
+        for (int j = 0; j < n; ++j) d[j] = u[j] + v[j];
+    }
+  };
+  S21ParallelRows(0, m, n, rows);
+}
+
+// C += A * B where A is m x k and B is k x n. Even halves go through the
+// seven-product Winograd schedule, odd trailing rows and columns are peeled
+// off and added with the classical kernel.
+template <typename T>
+static void Strassen(int m, int n, int k, const T* a, int lda, const T* b,
+                     int ldb, T* c, int ldc, T* scratch, int crossover) {
+  if (!Splits(m, n, k, crossover))
+    return ClassicalGemm(m, n, k, a, lda, b, ldb, c, ldc);
+
+  const int hm = m / 2, hn = n / 2, hk = k / 2;
+  const T *a11 = a, *a12 = a + hk, *a21 = a + std::ptrdiff_t(hm) * lda,
+          *a22 = a21 + hk;
+  const T *b11 = b, *b12 = b + hn, *b21 = b + std::ptrdiff_t(hk) * ldb,
+          *b22 = b21 + hn;
+  T *c11 = c, *c12 = c + hn, *c21 = c + std::ptrdiff_t(hm) * ldc,
+    *c22 = c21 + hn;
+  T *s = scratch, *t = s + std::size_t(hm) * hk, *p = t + std::size_t(hk) * hn,
+    *next = p + std::size_t(hm) * hn;
+
+  // p = x * y from zero, then added into every listed C block with sign
+  auto product = [&](const T* x, int ldx, const T* y, int ldy,
+                     std::initializer_list<std::pair<T*, int>> to) {
+    std::fill_n(p, std::size_t(hm) * hn, T());
+    Strassen(hm, hn, hk, x, ldx, y, ldy, p, hn, next, crossover);
+    for (const auto& block : to)
+      Combine(hm, hn, block.first, ldc, block.first, ldc, p, hn,
+              block.second);
+  };
+
+  Combine(hm, hk, s, hk, a21, lda, a22, lda, 1);   // S1 = A21 + A22
+  Combine(hk, hn, t, hn, b12, ldb, b11, ldb, -1);  // T1 = B12 - B11
+  product(s, hk, t, hn, {{c12, 1}, {c22, 1}});     // P5 = S1 * T1
+  Combine(hm, hk, s, hk, s, hk, a11, lda, -1);     // S2 = S1 - A11
+  Combine(hk, hn, t, hn, b22, ldb, t, hn, -1);     // T2 = B22 - T1
+  product(s, hk, t, hn, {{c12, 1}, {c21, 1}, {c22, 1}});  // P6 = S2 * T2
+  Combine(hm, hk, s, hk, a12, lda, s, hk, -1);     // S4 = A12 - S2
+  product(s, hk, b22, ldb, {{c12, 1}});            // P3 = S4 * B22
+  Combine(hk, hn, t, hn, t, hn, b21, ldb, -1);     // T4 = T2 - B21
+  product(a22, lda, t, hn, {{c21, -1}});           // P4 = A22 * T4
+  Combine(hm, hk, s, hk, a11, lda, a21, lda, -1);  // S3 = A11 - A21
+  Combine(hk, hn, t, hn, b22, ldb, b12, ldb, -1);  // T3 = B22 - B12
+  product(s, hk, t, hn, {{c21, 1}, {c22, 1}});     // P7 = S3 * T3
+  product(a11, lda, b11, ldb, {{c11, 1}, {c12, 1}, {c21, 1}, {c22, 1}});
+  Strassen(hm, hn, hk, a12, lda, b21, ldb, c11, ldc, next, crossover);
+
+  const int m2 = 2 * hm, n2 = 2 * hn, k2 = 2 * hk;
+  if (k2 < k)
+    ClassicalGemm(m2, n2, 1, a + k2, lda, b + std::ptrdiff_t(k2) * ldb, ldb,
+                  c, ldc);
+  if (n2 < n) ClassicalGemm(m2, 1, k, a, lda, b + n2, ldb, c + n2, ldc);
+  if (m2 < m)
+    ClassicalGemm(1, n, k, a + std::ptrdiff_t(m2) * lda, lda, b, ldb,
+                  c + std::ptrdiff_t(m2) * ldc, ldc);
+}
+
+template <typename T>
+void S21Gemm(int m, int n, int k, const T* a, int lda, const T* b, int ldb,
+             T* c, int ldc) {
+  const int crossover = tNoStrassen ? 0 : int(strassenCrossover);
+  if (!Splits(m, n, k, crossover))
+    return ClassicalGemm(m, n, k, a, lda, b, ldb, c, ldc);
+  PackBuffer<T> scratch(StrassenScratch(m, n, k, crossover));
+  Strassen(m, n, k, a, lda, b, ldb, c, ldc, scratch.data, crossover);
+}
+
+#define INSTANTIATE(T)                                                     \
+  template void S21Gemm<T>(int m, int n, int k, const T* a, int lda,       \
+                           const T* b, int ldb, T* c, int ldc);
+S21_ELEMENT_TYPES(INSTANTIATE)
@@ -0,0 +1,42 @@
+#ifndef S21_GEMM_H
+#define S21_GEMM_H
+
+//=================   GEMM TILING   ======================
+// MR x NR is the register tile, KC x NR panels of B stay in L1, MC x KC
+// blocks of A in L2 and KC x NC panels of B in L3. NR counts doubles; other
+// element types keep the same bytes per tile row.
+#define GEMM_MR 4
+#define GEMM_NR 8
+#define GEMM_KC 256
+#define GEMM_MC 96
+#define GEMM_NC 2048
+// column slice handed to one thread when C has too few MC-row blocks
+#define GEMM_SLICE 256
+
+// products whose three dimensions all reach this size recurse through
+// Strassen-Winograd; the default keeps it to 2048 and up
+#define GEMM_STRASSEN 2048
+
+// C(m x n) += A(m x k) * B(k x n), all row-major with leading dimensions,
+// for every type in S21_ELEMENT_TYPES.
+template <typename T>
+void S21Gemm(int m, int n, int k, const T* a, int lda, const T* b, int ldb,
+             T* c, int ldc);
+
+//=================   STRASSEN CONTROL   ======================
+// Each Strassen level saves an eighth of the multiplies but loosens the
+// error bound from the classical n * eps * |A| * |B| elementwise to a
+// normwise one. 0 turns it off for the whole process.
+int S21GetStrassenCrossover();
+void S21SetStrassenCrossover(int size);
+
+// products issued from this thread while it lives use the classical kernel
+class S21NoStrassen {
+ public:
+  S21NoStrassen();
+  ~S21NoStrassen();
+  S21NoStrassen(const S21NoStrassen&) = delete;
+  S21NoStrassen& operator=(const S21NoStrassen&) = delete;
+};
+
+#endif  // S21_GEMM_H
@@ -0,0 +1,61 @@
+#include "s21_lu.h"
+
+#include "s21_simd.h"
+
+#define TMPL template <typename T>
+#define LU S21BasicLU<T>
+
+//=================  CONSTRUCTORS   ======================
+
+TMPL LU::S21BasicLU(const S21BasicMatrix<T> &matrix)
+    : lu_(matrix), pivots_(matrix.GetRows()) {
+  lu_.CheckSquare();
+  det_ = lu_.FactorLU(pivots_.data(), &singular_);
+}
+
+//=================   OPERATIONS   ======================
+
+TMPL S21BasicMatrix<T> LU::Inverse() const {
+  S21BasicMatrix<T> result(GetSize(), GetSize());
+  FOR(GetSize()) result(i, i) = 1;
+  return SolveInPlace(result), result;
+}
+
+TMPL S21BasicVector<T> LU::Solve(const S21BasicVector<T> &b) const {
+  S21BasicVector<T> x = b;
+  return SolveInPlace(x), x;
+}
+
+TMPL S21BasicMatrix<T> LU::Solve(const S21BasicMatrix<T> &b) const {
+  S21BasicMatrix<T> x = b;
+  return SolveInPlace(x), x;
+}
+
+// L * y = P * b, then U * x = y, each entry one dot with a factor row
+TMPL void LU::SolveInPlace(S21BasicVector<T> &b) const {
+  CheckSolvable(b.GetSize());
+  const S21Kernels<T> &kernels = S21GetKernels<T>();
+  const int n = GetSize();
+  T *x = b.Data();
+  FOR(n) std::swap(x[i], x[pivots_[i]]);
+  for (int i = 1; i < n; ++i) x[i] -= kernels.dot(i, lu_.Row(i).Data(), x);
+  for (int i = n - 1; i >= 0; --i) {
+    const T *u = lu_.Row(i).Data();
+    x[i] = (x[i] - kernels.dot(n - i - 1, u + i + 1, x + i + 1)) / u[i];
+  }
+}
+
+TMPL void LU::SolveInPlace(S21BasicMatrix<T> &b) const {
+  CheckSolvable(b.GetRows());
+  lu_.SolveLU(pivots_.data(), b);
+}
+
+//=================   SUPPLEMENTARY   ======================
+
+TMPL void LU::CheckSolvable(int rows) const {
+  if (rows != GetSize()) throw std::invalid_argument("Invalid sizes");
+  if (IsSingular()) throw std::logic_error("Determinant cannot be 0");
+}
+
+#define INSTANTIATE(T) template class S21BasicLU<T>;
+S21_FLOATING_TYPES(INSTANTIATE)
@@ -0,0 +1,58 @@
+#ifndef S21_LU_H
+#define S21_LU_H
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+//=================   LU FACTORIZATION   ======================
+// P * A = L * U, factored once by the blocked FactorLU and kept: every
+// Solve is then two triangular sweeps, O(n^2) per right-hand side instead
+// of a new factorization or an explicit inverse. Only for the types in
+// S21_FLOATING_TYPES; integer matrices keep the exact Determinant and
+// InverseMatrix of S21BasicMatrix.
+
+template <typename T>
+class S21BasicLU {
+  static_assert(!S21Traits<T>::kExact, "LU divides by its pivots");
+
+ public:
+  using Scalar = T;
+
+  //=================  CONSTRUCTORS   ======================
+  // a singular matrix factors too; only solving with it throws
+  explicit S21BasicLU(const S21BasicMatrix<T>& matrix);
+
+  //=================   GET   ======================
+  int GetSize() const { return lu_.GetRows(); }
+  // some pivot is negligible next to the largest |entry|, as FactorLU
+  // judges it; the determinant alone says nothing about that
+  bool IsSingular() const { return singular_; }
+  // L strictly below the diagonal (its unit diagonal implied), U on and
+  // above; row k was swapped with GetPivots()[k] while factoring
+  const S21BasicMatrix<T>& GetFactors() const { return lu_; }
+  const std::vector<int>& GetPivots() const { return pivots_; }
+
+  //=================   OPERATIONS   ======================
+  T Determinant() const { return det_; }
+  S21BasicMatrix<T> Inverse() const;
+  // X with A * X = b, for one or many right-hand sides
+  S21BasicVector<T> Solve(const S21BasicVector<T>& b) const;
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T>& b) const;
+  // the same, overwriting b and allocating nothing
+  void SolveInPlace(S21BasicVector<T>& b) const;
+  void SolveInPlace(S21BasicMatrix<T>& b) const;
+
+  //=================   SUPPLEMENTARY   ======================
+  void CheckSolvable(int rows) const;
+
+ private:
+  S21BasicMatrix<T> lu_;
+  std::vector<int> pivots_;
+  T det_;
+  bool singular_;
+};
+
+using S21LU = S21BasicLU<double>;
+
+#endif  // S21_LU_H
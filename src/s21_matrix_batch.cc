@@ -0,0 +1,292 @@
+#include "s21_matrix_batch.h"
+
+#include "s21_lu.h"
+#include "s21_thread_pool.h"
+
+#define TMPL template <typename T>
+#define BATCH S21BasicMatrixBatch<T>
+#define LANE for (int l = 0; l < kLanes; l++)
+// element (row, col) of an interleaved group with width columns
+#define AT(w, row, col) ((w) + ((row) * width + (col)) * kLanes)
+// Largest sizes the interleaved kernels take. Past them the blocked
+// single-matrix paths, fed a group unpacked at a time, win: on one
+// AVX-512 core the products tie at 28, inverses cross between 32 and 40,
+// and determinants stay level from 48 on.
+#define BATCH_MUL_MAX 28
+#define BATCH_DETERMINANT_MAX 48
+#define BATCH_INVERSE_MAX 32
+
+// Per lane, swaps row k of the n x width group w with the row at or below
+// it holding the largest |w(r, k)|, from column k on. best gets the rows.
+template <int kLanes, typename T>
+static void Pivot(int n, int width, int k, T *w, int *best) {
+  typename S21Traits<T>::Real largest[kLanes];
+  LANE best[l] = k, largest[l] = S21Abs(AT(w, k, k)[l]);
+  for (int r = k + 1; r < n; r++) LANE {
+      const auto x = S21Abs(AT(w, r, k)[l]);
+      best[l] = x > largest[l] ? r : best[l];
+      largest[l] = x > largest[l] ? x : largest[l];
+    }
+  for (int j = k; j < width; j++) {
+    T *x = AT(w, k, j);
+    LANE std::swap(x[l], AT(w, best[l], j)[l]);
+  }
+}
+
+// entry := its inverse as InverseMatrix finds it, or zeros and false when it
+// is singular: an exact zero determinant for integers, else S21LU's pivots
+template <typename T>
+static bool Invert(S21BasicMatrix<T> &entry) {
+  bool singular;
+  if constexpr (S21Traits<T>::kExact) {
+    singular = entry.Determinant() == T(0);
+    if (!singular) entry = entry.InverseMatrix();
+  } else {
+    const S21BasicLU<T> lu(entry);
+    singular = lu.IsSingular();
+    if (!singular) entry = lu.Inverse();
+  }
+  if (singular) entry = S21BasicMatrix<T>(entry.GetRows(), entry.GetCols());
+  return !singular;
+}
+
+// lists the flagged entries in singular, or throws if there is none to list
+static void ReportSingular(const std::vector<char> &failed,
+                           std::vector<int> *singular) {
+  if (singular) singular->clear();
+  for (int b = 0; b < int(failed.size()); b++)
+    if (failed[b]) {
+      if (!singular) throw std::logic_error("Determinant cannot be 0");
+      singular->push_back(b);
+    }
+}
+
+//=================   CONSTRUCTORS   ======================
+
+TMPL BATCH::S21BasicMatrixBatch() : count_{}, rows_{}, cols_{} {}
+
+TMPL BATCH::S21BasicMatrixBatch(int count, int rows, int cols)
+    : count_(count),
+      rows_(rows),
+      cols_(cols),
+      // throws for any size below 1
+      data_((count + kLanes - 1) / kLanes, rows * cols * kLanes) {}
+
+//=================   GET/SET   ======================
+
+TMPL S21BasicMatrix<T> BATCH::GetMatrix(int index) const {
+  CheckBounds(index, 0, 0);
+  return S21BasicMatrix<T>(Entry(index));
+}
+
+TMPL void BATCH::SetMatrix(int index, const S21BasicMatrix<T> &matrix) {
+  CheckBounds(index, 0, 0);
+  if (matrix.GetRows() != rows_ || matrix.GetCols() != cols_)
+    throw std::invalid_argument("Unequal size of matrices");
+  Entry(index).Assign(matrix);
+}
+
+TMPL void BATCH::Unpack(int group, S21BasicMatrix<T> *entries) const {
+  const int lanes = Lanes(group);
+  for (int l = 0; l < lanes; l++)
+    if (entries[l].GetRows() != rows_ || entries[l].GetCols() != cols_)
+      entries[l] = S21BasicMatrix<T>(rows_, cols_);
+  const T *from = Group(group);
+  FOR(rows_) {
+    T *row[kLanes];
+    for (int l = 0; l < lanes; l++) row[l] = entries[l].Row(i).Data();
+    for (int j = 0; j < cols_; j++, from += kLanes)
+      for (int l = 0; l < lanes; l++) row[l][j] = from[l];
+  }
+}
+
+TMPL void BATCH::Pack(int group, const S21BasicMatrix<T> *entries) {
+  const int lanes = Lanes(group);
+  T *to = Group(group);
+  FOR(rows_) {
+    const T *row[kLanes];
+    for (int l = 0; l < lanes; l++) row[l] = entries[l].Row(i).Data();
+    for (int j = 0; j < cols_; j++, to += kLanes)
+      for (int l = 0; l < lanes; l++) to[l] = row[l][j];
+  }
+}
+
+//=================   BATCH KERNELS   ======================
+
+TMPL void BATCH::BatchMulMatrix(const BATCH &other) {
+  if (count_ != other.count_ || cols_ != other.rows_)
+    throw std::invalid_argument("Invalid sizes");
+  const int k = cols_, n = other.cols_, groups = data_.GetRows();
+  if (std::max({rows_, k, n}) > BATCH_MUL_MAX) {
+    // a square product goes back over its own group, sparing the new batch
+    BATCH result = n == k ? BATCH() : BATCH(count_, rows_, n);
+    BATCH &target = n == k ? *this : result;
+    S21ParallelRows(0, groups, rows_ * n * k * kLanes, [&](int from, int to) {
+      std::vector<S21BasicMatrix<T>> a(kLanes), b(kLanes), c(kLanes);
+      for (int g = from; g < to; ++g) {
+        Unpack(g, a.data()), other.Unpack(g, b.data());
+        for (int l = 0; l < Lanes(g); l++) c[l] = a[l] * b[l];
+        target.Pack(g, c.data());
+      }
+    });
+    if (n != k) *this = std::move(result);
+    return;
+  }
+  BATCH result(count_, rows_, n);
+  S21ParallelRows(0, groups, rows_ * n * k * kLanes, [&](int from, int to) {
+    for (int g = from; g < to; ++g) {
+      const T *a = Group(g), *b = other.Group(g);
+      T *c = result.Group(g);
+      FORJ(rows_, n) {
+        T sum[kLanes] = {};
+        for (int p = 0; p < k; p++) {
+          const T *x = a + (i * k + p) * kLanes, *y = b + (p * n + j) * kLanes;
+          LANE sum[l] += x[l] * y[l];
+        }
+        std::copy_n(sum, kLanes, c + (i * n + j) * kLanes);
+      }
+    }
+  });
+  *this = std::move(result);
+}
+
+// forward elimination with per-lane partial pivoting on a scratch copy
+TMPL std::vector<T> BATCH::BatchDeterminant() const {
+  CheckSquare();
+  std::vector<T> result(count_);
+  const int n = rows_, width = n, groups = data_.GetRows();
+  if (S21Traits<T>::kExact || n > BATCH_DETERMINANT_MAX) {
+    S21ParallelRows(0, groups, n * n * n * kLanes, [&](int from, int to) {
+      std::vector<S21BasicMatrix<T>> entries(kLanes);
+      for (int g = from; g < to; ++g) {
+        Unpack(g, entries.data());
+        for (int l = 0; l < Lanes(g); l++)
+          result[g * kLanes + l] = entries[l].Determinant();
+      }
+    });
+    return result;
+  }
+  S21ParallelRows(0, groups, n * n * n * kLanes, [&](int from, int to) {
+    std::vector<T> scratch(std::size_t(n) * n * kLanes);
+    T *w = scratch.data(), det[kLanes], inverse[kLanes];
+    int best[kLanes];
+    for (int g = from; g < to; ++g) {
+      std::copy_n(Group(g), scratch.size(), w);
+      LANE det[l] = 1;
+      for (int k = 0; k < n; k++) {
+        Pivot<kLanes>(n, width, k, w, best);
+        LANE {
+          const T pivot = AT(w, k, k)[l];
+          det[l] *= best[l] == k ? pivot : -pivot;
+          inverse[l] = pivot == T(0) ? T(0) : T(1) / pivot;
+        }
+        for (int r = k + 1; r < n; r++) {
+          T factor[kLanes];
+          LANE factor[l] = AT(w, r, k)[l] * inverse[l];
+          for (int j = k + 1; j < n; j++) {
+            T *x = AT(w, r, j);
+            const T *y = AT(w, k, j);
+            LANE x[l] -= factor[l] * y[l];
+          }
+        }
+      }
+      for (int l = 0; l < kLanes && g * kLanes + l < count_; l++)
+        result[g * kLanes + l] = det[l];
+    }
+  });
+  return result;
+}
+
+// Gauss-Jordan on [A | I] with per-lane partial pivoting; failed holds one
+// flag per entry, so groups never write to the same byte
+TMPL BATCH BATCH::BatchInverse(std::vector<int> *singular) const {
+  CheckSquare();
+  BATCH result(count_, rows_, cols_);
+  const int n = rows_, width = 2 * n, groups = data_.GetRows();
+  std::vector<char> failed(count_);
+  if (S21Traits<T>::kExact || n > BATCH_INVERSE_MAX) {
+    S21ParallelRows(0, groups, 2 * n * n * n * kLanes, [&](int from, int to) {
+      std::vector<S21BasicMatrix<T>> entries(kLanes);
+      for (int g = from; g < to; ++g) {
+        Unpack(g, entries.data());
+        for (int l = 0; l < Lanes(g); l++)
+          failed[g * kLanes + l] = !Invert(entries[l]);
+        result.Pack(g, entries.data());
+      }
+    });
+    return ReportSingular(failed, singular), result;
+  }
+  S21ParallelRows(0, groups, 2 * n * n * n * kLanes, [&](int from, int to) {
+    std::vector<T> scratch(std::size_t(n) * width * kLanes);
+    T *w = scratch.data(), inverse[kLanes];
+    typename S21Traits<T>::Real scale[kLanes];
+    bool negligible[kLanes];
+    int best[kLanes];
+    for (int g = from; g < to; ++g) {
+      const T *a = Group(g);
+      std::fill(scratch.begin(), scratch.end(), T());
+      LANE scale[l] = 0, negligible[l] = false;
+      FOR(n) {
+        std::copy_n(a + i * n * kLanes, n * kLanes, AT(w, i, 0));
+        LANE AT(w, i, n + i)[l] = 1;
+        for (int j = 0; j < n; j++)
+          LANE scale[l] = std::max(scale[l], S21Abs(AT(w, i, j)[l]));
+      }
+      for (int k = 0; k < n; k++) {
+        Pivot<kLanes>(n, width, k, w, best);
+        LANE {
+          const T pivot = AT(w, k, k)[l];
+          negligible[l] |= S21NegligiblePivot(pivot, n, scale[l]);
+          inverse[l] = pivot == T(0) ? T(0) : T(1) / pivot;
+        }
+        for (int j = k; j < width; j++) LANE AT(w, k, j)[l] *= inverse[l];
+        for (int r = 0; r < n; r++) {
+          if (r == k) continue;
+          T factor[kLanes];
+          LANE factor[l] = AT(w, r, k)[l];
+          for (int j = k; j < width; j++) {
+            T *x = AT(w, r, j);
+            const T *y = AT(w, k, j);
+            LANE x[l] -= factor[l] * y[l];
+          }
+        }
+      }
+      T *c = result.Group(g);
+      FOR(n) std::copy_n(AT(w, i, n), n * kLanes, c + i * n * kLanes);
+      for (int l = 0; l < kLanes && g * kLanes + l < count_; l++)
+        if (negligible[l]) {
+          failed[g * kLanes + l] = true;
+          for (int e = 0; e < n * n; e++) c[e * kLanes + l] = 0;
+        }
+    }
+  });
+  return ReportSingular(failed, singular), result;
+}
+
+//=================   OPERATOR OVERLOAD   ======================
+
+TMPL T &BATCH::operator()(int index, int row, int col) {
+  return CheckBounds(index, row, col),
+         Group(index / kLanes)[Slot(index, row, col)];
+}
+
+TMPL T BATCH::operator()(int index, int row, int col) const {
+  return CheckBounds(index, row, col),
+         Group(index / kLanes)[Slot(index, row, col)];
+}
+
+//=================   SUPPLEMENTARY   ======================
+
+TMPL void BATCH::CheckBounds(int index, int row, int col) const {
+  if (index < 0 || row < 0 || col < 0)
+    throw std::out_of_range("Less than 0 exception");
+  else if (index >= count_ || row >= rows_ || col >= cols_)
+    throw std::out_of_range("Out of bounds exception");
+}
+
+TMPL void BATCH::CheckSquare() const {
+  if (rows_ != cols_) throw std::logic_error("Matrix is not square");
+}
+
+#define INSTANTIATE(T) template class S21BasicMatrixBatch<T>;
+S21_ELEMENT_TYPES(INSTANTIATE)
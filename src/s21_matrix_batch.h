@@ -0,0 +1,87 @@
+#ifndef S21_MATRIX_BATCH_H
+#define S21_MATRIX_BATCH_H
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+//=================   MATRIX BATCHES   ======================
+// count independent rows x cols matrices, interleaved kLanes at a time:
+// element (row, col) of the kLanes entries of a group sits in kLanes
+// consecutive slots, so the batch kernels run each algorithm once per group
+// with every scalar step a kLanes-wide loop the compiler vectorizes.
+// Pivoting picks its row per lane with selects instead of branches. Groups
+// are independent and spread over the thread pool. Integer batches, and
+// sizes past the measured cutoffs in s21_matrix_batch.cc, take the
+// single-matrix paths entry by entry.
+
+template <typename T>
+class S21BasicMatrixBatch {
+ public:
+  using Scalar = T;
+  // one cache line of each element per group
+  static constexpr int kLanes = 64 / sizeof(T);
+
+  //=================  CONSTRUCTORS   ======================
+  S21BasicMatrixBatch();
+  // count zero matrices
+  S21BasicMatrixBatch(int count, int rows, int cols);
+
+  //=================   GET/SET   ======================
+  int GetCount() const { return count_; }
+  int GetRows() const { return rows_; }
+  int GetCols() const { return cols_; }
+  S21BasicMatrix<T> GetMatrix(int index) const;
+  void SetMatrix(int index, const S21BasicMatrix<T>& matrix);
+
+  //=================   BATCH KERNELS   ======================
+  // entry by entry, with the semantics of MulMatrix, Determinant and
+  // InverseMatrix. BatchInverse tests each entry's pivots as FactorLU does:
+  // a singular entry is left zero and its index goes to singular, in
+  // ascending order; without singular, any such entry throws instead.
+  void BatchMulMatrix(const S21BasicMatrixBatch& other);
+  std::vector<T> BatchDeterminant() const;
+  S21BasicMatrixBatch BatchInverse(std::vector<int>* singular = nullptr) const;
+
+  //=================   OPERATOR OVERLOAD   ======================
+  T& operator()(int index, int row, int col);
+  T operator()(int index, int row, int col) const;
+
+  //=================   SUPPLEMENTARY   ======================
+  void CheckBounds(int index, int row, int col) const;
+  void CheckSquare() const;
+
+ private:
+  T* Group(int group) { return data_.Row(group).Data(); }
+  const T* Group(int group) const { return data_.Row(group).Data(); }
+  // of element (row, col) of entry index within its group
+  int Slot(int index, int row, int col) const {
+    return (row * cols_ + col) * kLanes + index % kLanes;
+  }
+  // entry index in place, every kLanes-th element of its group
+  S21BasicMatrixView<const T> Entry(int index) const {
+    return {Group(index / kLanes) + index % kLanes, rows_, cols_,
+            std::ptrdiff_t(cols_) * kLanes, kLanes};
+  }
+  S21BasicMatrixView<T> Entry(int index) {
+    return {Group(index / kLanes) + index % kLanes, rows_, cols_,
+            std::ptrdiff_t(cols_) * kLanes, kLanes};
+  }
+  // entries in use in the group: kLanes but in the last one
+  int Lanes(int group) const {
+    return std::min(kLanes, count_ - group * kLanes);
+  }
+  // the entries of a group to and from rows_ x cols_ matrices, reading or
+  // writing the group once in order
+  void Unpack(int group, S21BasicMatrix<T>* entries) const;
+  void Pack(int group, const S21BasicMatrix<T>* entries);
+
+  int count_, rows_, cols_;
+  // one row of rows_ * cols_ * kLanes elements per group, kept aligned
+  // by S21BasicMatrix
+  S21BasicMatrix<T> data_;
+};
+
+using S21MatrixBatch = S21BasicMatrixBatch<double>;
+
+#endif  // S21_MATRIX_BATCH_H
@@ -0,0 +1,252 @@
+#ifndef S21_MATRIX_EXPR_H
+#define S21_MATRIX_EXPR_H
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "s21_matrix_oop.h"
+#include "s21_thread_pool.h"
+
+//=================   EXPRESSION TEMPLATES   ======================
+// A + B - C * 2.0 builds a tree of these instead of three temporaries; the
+// tree is evaluated element by element in one pass over the rows when it
+// is assigned to an S21Matrix. Products are computed eagerly and join the
+// tree as owned leaves, so a chain never dangles on a temporary. Spare()
+// hands out such an owned leaf: an expiring tree is evaluated in place into
+// it and its buffer becomes the result without a new allocation. Every node
+// carries the element type of its leaves as Scalar; leaves of different
+// element types do not mix.
+
+template <typename E>
+class S21Expr {
+ public:
+  const E& Self() const { return static_cast<const E&>(*this); }
+  template <typename T>
+  bool operator==(const S21BasicMatrix<T>& other) const {
+    return S21BasicMatrix<T>(*this).EqMatrix(other);
+  }
+  template <typename F>
+  bool operator==(const S21Expr<F>& other) const {
+    using Matrix = S21BasicMatrix<typename F::Scalar>;
+    return Matrix(*this).EqMatrix(Matrix(other));
+  }
+};
+
+// lvalues are referenced, expiring matrices are moved into the tree
+template <typename T, bool Owned>
+class S21MatrixRef : public S21Expr<S21MatrixRef<T, Owned>> {
+ public:
+  using Scalar = T;
+  template <typename M>
+  explicit S21MatrixRef(M&& matrix) : matrix_(std::forward<M>(matrix)) {}
+  int GetRows() const { return matrix_.rows_; }
+  int GetCols() const { return matrix_.cols_; }
+  T At(int row, int col) const { return matrix_.RowPtr(row)[col]; }
+  S21BasicMatrix<T>* Spare() {
+    if constexpr (Owned) return &matrix_;
+    return nullptr;
+  }
+
+ private:
+  std::conditional_t<Owned, S21BasicMatrix<T>, const S21BasicMatrix<T>&>
+      matrix_;
+};
+
+template <typename L, typename R, typename Op>
+class S21BinaryExpr : public S21Expr<S21BinaryExpr<L, R, Op>> {
+ public:
+  using Scalar = typename L::Scalar;
+  static_assert(std::is_same_v<Scalar, typename R::Scalar>,
+                "Unequal element types");
+
+  S21BinaryExpr(L lhs, R rhs) : lhs_(std::move(lhs)), rhs_(std::move(rhs)) {
+    if (lhs_.GetRows() != rhs_.GetRows() || lhs_.GetCols() != rhs_.GetCols())
+      throw std::invalid_argument("Unequal size of matrices");
+  }
+  int GetRows() const { return lhs_.GetRows(); }
+  int GetCols() const { return lhs_.GetCols(); }
+  Scalar At(int row, int col) const {
+    return Op()(lhs_.At(row, col), rhs_.At(row, col));
+  }
+  S21BasicMatrix<Scalar>* Spare() {
+    S21BasicMatrix<Scalar>* spare = lhs_.Spare();
+    return spare ? spare : rhs_.Spare();
+  }
+
+ private:
+  L lhs_;
+  R rhs_;
+};
+
+template <typename E>
+class S21ScaleExpr : public S21Expr<S21ScaleExpr<E>> {
+ public:
+  using Scalar = typename E::Scalar;
+
+  S21ScaleExpr(E expr, Scalar num) : expr_(std::move(expr)), num_(num) {}
+  int GetRows() const { return expr_.GetRows(); }
+  int GetCols() const { return expr_.GetCols(); }
+  Scalar At(int row, int col) const { return expr_.At(row, col) * num_; }
+  S21BasicMatrix<Scalar>* Spare() { return expr_.Spare(); }
+
+ private:
+  E expr_;
+  Scalar num_;
+};
+
+//=================   OPERANDS   ======================
+
+template <typename T>
+S21MatrixRef<T, false> S21Wrap(const S21BasicMatrix<T>& matrix) {
+  return S21MatrixRef<T, false>(matrix);
+}
+template <typename T>
+S21MatrixRef<T, true> S21Wrap(S21BasicMatrix<T>&& matrix) {
+  return S21MatrixRef<T, true>(std::move(matrix));
+}
+template <typename E>
+E S21Wrap(const S21Expr<E>& expr) {
+  return expr.Self();
+}
+template <typename E>
+E S21Wrap(S21Expr<E>&& expr) {
+  return std::move(static_cast<E&>(expr));
+}
+
+template <typename T>
+using S21Wrapped = decltype(S21Wrap(std::declval<T>()));
+
+template <typename T>
+using S21ScalarOf = typename S21Wrapped<T>::Scalar;
+
+template <typename T>
+struct S21IsMatrix : std::false_type {};
+template <typename T>
+struct S21IsMatrix<S21BasicMatrix<T>> : std::true_type {};
+
+template <typename T, typename D = std::decay_t<T>>
+constexpr bool kS21Operand =
+    S21IsMatrix<D>::value || std::is_base_of_v<S21Expr<D>, D>;
+
+#define S21_OPERANDS(L, R) \
+  typename = std::enable_if_t<kS21Operand<L> && kS21Operand<R>>
+
+// products need real storage: matrices pass through, trees are evaluated
+template <typename T>
+const S21BasicMatrix<T>& S21Eval(const S21BasicMatrix<T>& matrix) {
+  return matrix;
+}
+template <typename E>
+S21BasicMatrix<typename E::Scalar> S21Eval(const S21Expr<E>& expr) {
+  return S21BasicMatrix<typename E::Scalar>(expr);
+}
+
+//=================   OPERATORS   ======================
+
+template <typename L, typename R, S21_OPERANDS(L, R)>
+S21BinaryExpr<S21Wrapped<L>, S21Wrapped<R>, std::plus<>> operator+(L&& lhs,
+                                                                   R&& rhs) {
+  return {S21Wrap(std::forward<L>(lhs)), S21Wrap(std::forward<R>(rhs))};
+}
+
+template <typename L, typename R, S21_OPERANDS(L, R)>
+S21BinaryExpr<S21Wrapped<L>, S21Wrapped<R>, std::minus<>> operator-(L&& lhs,
+                                                                    R&& rhs) {
+  return {S21Wrap(std::forward<L>(lhs)), S21Wrap(std::forward<R>(rhs))};
+}
+
+template <typename L, S21_OPERANDS(L, L)>
+S21ScaleExpr<S21Wrapped<L>> operator*(L&& lhs, S21ScalarOf<L> num) {
+  return {S21Wrap(std::forward<L>(lhs)), num};
+}
+
+template <typename R, S21_OPERANDS(R, R)>
+S21ScaleExpr<S21Wrapped<R>> operator*(S21ScalarOf<R> num, R&& rhs) {
+  return {S21Wrap(std::forward<R>(rhs)), num};
+}
+
+template <typename L, typename R, S21_OPERANDS(L, R)>
+S21BasicMatrix<S21ScalarOf<L>> operator*(L&& lhs, R&& rhs) {
+  return S21BasicMatrix<S21ScalarOf<L>>::Product(S21Eval(lhs), S21Eval(rhs));
+}
+
+//=================   EVALUATION   ======================
+
+template <typename T>
+template <typename E>
+S21BasicMatrix<T>::S21BasicMatrix(const S21Expr<E>& expr)
+    : rows_(expr.Self().GetRows()),
+      cols_(expr.Self().GetCols()),
+      stride_{},
+      matrix_{} {
+  static_assert(std::is_same_v<T, typename E::Scalar>,
+                "Unequal element types");
+  Allocate(), Evaluate(expr.Self(), [](T& dst, T x) { dst = x; });
+}
+
+template <typename T>
+template <typename E>
+S21BasicMatrix<T>::S21BasicMatrix(S21Expr<E>&& expr) : S21BasicMatrix() {
+  *this = std::move(expr);
+}
+
+// any tree that reads *this has this shape, so a reshape never aliases
+template <typename T>
+template <typename E>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(const S21Expr<E>& expr) {
+  static_assert(std::is_same_v<T, typename E::Scalar>,
+                "Unequal element types");
+  const E& tree = expr.Self();
+  if (rows_ != tree.GetRows() || cols_ != tree.GetCols())
+    ClearMatrix(), rows_ = tree.GetRows(), cols_ = tree.GetCols(), Allocate();
+  Evaluate(tree, [](T& dst, T x) { dst = x; });
+  return *this;
+}
+
+template <typename T>
+template <typename E>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(S21Expr<E>&& expr) {
+  E& tree = static_cast<E&>(expr);
+  S21BasicMatrix* spare = tree.Spare();
+  if (!spare || (rows_ == tree.GetRows() && cols_ == tree.GetCols()))
+    return *this = static_cast<const S21Expr<E>&>(expr);
+  spare->Evaluate(tree, [](T& dst, T x) { dst = x; });
+  return *this = std::move(*spare);
+}
+
+template <typename T>
+template <typename E>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator+=(const S21Expr<E>& expr) {
+  if (rows_ != expr.Self().GetRows() || cols_ != expr.Self().GetCols())
+    throw std::invalid_argument("Unequal size of matrices");
+  Evaluate(expr.Self(), [](T& dst, T x) { dst += x; });
+  return *this;
+}
+
+template <typename T>
+template <typename E>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator-=(const S21Expr<E>& expr) {
+  if (rows_ != expr.Self().GetRows() || cols_ != expr.Self().GetCols())
+    throw std::invalid_argument("Unequal size of matrices");
+  Evaluate(expr.Self(), [](T& dst, T x) { dst -= x; });
+  return *this;
+}
+
+template <typename T>
+template <typename E, typename Op>
+void S21BasicMatrix<T>::Evaluate(const E& expr, Op op) {
+  S21_PROFILE_SCOPE(Evaluate);
+  Detach();
+  auto rows = [&](int from, int to) {
+    for (int i = from; i < to; ++i) {
+      T* dst = RowPtr(i);
+      for (int j = 0; j < cols_; ++j) op(dst[j], expr.At(i, j));
+    }
+  };
+  S21ParallelRows(0, rows_, cols_, rows);
+}
+
+#endif  // S21_MATRIX_EXPR_H
@@ -0,0 +1,269 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <climits>
+#include <future>
+#include <utility>
+
+#include "s21_gemm.h"
+#include "s21_matrix_oop.h"
+
+//=================   FILE FORMAT   ======================
+// One S21_FILE_ALIGN-byte header, then the rows exactly as they sit in
+// memory: stride_ elements each, padding included. The payload starts one
+// block into a page-aligned mapping, so a mapped matrix is as aligned as an
+// allocated one and OpenMapped never parses or copies it. All fields are
+// native-endian; a foreign file fails the version check.
+
+#define S21_FILE_VERSION 1u
+#define S21_FILE_ALIGN 64
+#define S21_LAYOUT_ROW_MAJOR 0u
+#define CHUNK (std::size_t(1) << 20)
+#define FNV_BASIS 0xcbf29ce484222325ull
+
+struct S21FileHeader {
+  char magic[8];
+  std::uint32_t version, dtype, layout, alignment;
+  std::int64_t rows, cols, stride;
+  std::uint64_t checksum;  // of the payload
+  std::uint64_t reserved;
+};
+static_assert(sizeof(S21FileHeader) == S21_FILE_ALIGN, "One block header");
+
+static const char kMagic[8] = "S21MTRX";
+
+// closes on scope exit unless released first
+struct S21Fd {
+  explicit S21Fd(int fd) : fd(fd) {}
+  ~S21Fd() {
+    if (fd >= 0) ::close(fd);
+  }
+  int Release() { return std::exchange(fd, -1); }
+  int fd;
+};
+
+// word-wise FNV-1a; payloads are whole blocks, so whole words
+static std::uint64_t Checksum(std::uint64_t hash, const void *data,
+                              std::size_t bytes) {
+  const char *at = static_cast<const char *>(data);
+  for (std::size_t i = 0; i < bytes; i += sizeof(std::uint64_t)) {
+    std::uint64_t word;
+    std::memcpy(&word, at + i, sizeof word);
+    hash = (hash ^ word) * 0x100000001b3ull;
+  }
+  return hash;
+}
+
+static void WriteAll(int fd, const void *data, std::size_t bytes, off_t at) {
+  for (const char *from = static_cast<const char *>(data); bytes;) {
+    const ssize_t done = ::pwrite(fd, from, bytes, at);
+    if (done < 0) throw std::runtime_error("Can't write file");
+    from += done, at += done, bytes -= std::size_t(done);
+  }
+}
+
+static void ReadAll(int fd, void *data, std::size_t bytes, off_t at) {
+  for (char *to = static_cast<char *>(data); bytes;) {
+    const ssize_t done = ::pread(fd, to, bytes, at);
+    if (done <= 0) throw std::runtime_error("Can't read file");
+    to += done, at += done, bytes -= std::size_t(done);
+  }
+}
+
+static int Open(const std::string &path, int flags) {
+  const int fd = ::open(path.c_str(), flags, 0644);
+  if (fd < 0) throw std::runtime_error("Can't open " + path);
+  return fd;
+}
+
+// Written as path.tmp and renamed over path by Commit, since truncating
+// path in place would pull the pages from under a live mapping of the old
+// file. Removed unless committed, so a failed write leaves path as it was.
+struct S21NewFile : S21Fd {
+  explicit S21NewFile(const std::string &path)
+      : S21Fd(Open(path + ".tmp", O_RDWR | O_CREAT | O_TRUNC)),
+        path(path),
+        temporary(path + ".tmp") {}
+  ~S21NewFile() {
+    if (fd >= 0) ::unlink(temporary.c_str());
+  }
+  void Commit() {
+    if (::close(Release()) || ::rename(temporary.c_str(), path.c_str())) {
+      ::unlink(temporary.c_str());
+      throw std::runtime_error("Can't write " + path);
+    }
+  }
+  std::string path, temporary;
+};
+
+template <typename T>
+static S21FileHeader NewHeader(int rows, int cols, int stride) {
+  S21FileHeader header{};
+  std::memcpy(header.magic, kMagic, sizeof kMagic);
+  header.version = S21_FILE_VERSION, header.dtype = S21Traits<T>::kDtype;
+  header.layout = S21_LAYOUT_ROW_MAJOR, header.alignment = S21_FILE_ALIGN;
+  header.rows = rows, header.cols = cols, header.stride = stride;
+  header.checksum = FNV_BASIS;
+  return header;
+}
+
+// the header of a file of T elements, checked against the file size
+template <typename T>
+static S21FileHeader ReadHeader(int fd, const std::string &path) {
+  const std::int64_t lane = S21_FILE_ALIGN / sizeof(T);
+  S21FileHeader header;
+  struct stat file;
+  if (::fstat(fd, &file) ||
+      ::pread(fd, &header, sizeof header, 0) != sizeof header ||
+      std::memcmp(header.magic, kMagic, sizeof kMagic) ||
+      header.version != S21_FILE_VERSION ||
+      header.dtype != S21Traits<T>::kDtype ||
+      header.layout != S21_LAYOUT_ROW_MAJOR ||
+      header.alignment != S21_FILE_ALIGN || header.rows < 1 ||
+      header.cols < 1 || header.rows > INT_MAX || header.cols > INT_MAX ||
+      header.stride != (header.cols + lane - 1) / lane * lane ||
+      std::uint64_t(file.st_size) - sizeof header !=
+          std::uint64_t(header.rows * header.stride) * sizeof(T))
+    throw std::runtime_error("Not a matrix file of this type: " + path);
+  return header;
+}
+
+//=================   PERSISTENCE   ======================
+
+template <typename T>
+void S21BasicMatrix<T>::Save(const std::string &path) const {
+  S21_PROFILE_SCOPE(Save);
+  static_assert(kAlign == S21_FILE_ALIGN, "Files keep the memory layout");
+  if (!matrix_) throw std::logic_error("Can't save an empty matrix");
+  S21FileHeader header = NewHeader<T>(rows_, cols_, stride_);
+  S21NewFile file(path);
+  // streamed straight from the buffer, hashing each chunk while it is hot
+  const char *data = reinterpret_cast<const char *>(matrix_);
+  for (std::size_t at = 0; at < Bytes(); at += CHUNK) {
+    const std::size_t bytes = std::min(CHUNK, Bytes() - at);
+    header.checksum = Checksum(header.checksum, data + at, bytes);
+    WriteAll(file.fd, data + at, bytes, off_t(sizeof header + at));
+  }
+  WriteAll(file.fd, &header, sizeof header, 0);
+  file.Commit();
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::OpenMapped(const std::string &path,
+                                                S21MapMode mode, bool verify) {
+  S21_PROFILE_SCOPE(OpenMapped);
+  S21Fd file(Open(path, O_RDONLY));
+  const S21FileHeader header = ReadHeader<T>(file.fd, path);
+  S21BasicMatrix result;
+  result.rows_ = int(header.rows), result.cols_ = int(header.cols);
+  result.stride_ = int(header.stride);
+  const std::size_t size = sizeof header + result.Bytes();
+  void *base = ::mmap(nullptr, size,
+                      mode == kS21ReadOnly ? PROT_READ : PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE, file.fd, 0);
+  if (base == MAP_FAILED) throw std::runtime_error("Can't map " + path);
+  result.mapping_.reset(base, [size](void *ptr) { ::munmap(ptr, size); });
+  result.readOnly_ = mode == kS21ReadOnly;
+  result.matrix_ = reinterpret_cast<T *>(static_cast<char *>(base) + kAlign);
+  if (verify && Checksum(FNV_BASIS, result.matrix_, result.Bytes()) !=
+                    header.checksum)
+    throw std::runtime_error("Checksum mismatch: " + path);
+  return result;
+}
+
+//=================   OUT-OF-CORE PRODUCT   ======================
+
+// rows x cols elements at (row, col) of a file, to or from a tile
+template <typename T, typename Io, typename Ptr>
+static void TileIo(Io io, int fd, const S21FileHeader &header, int row,
+                   int col, int rows, int cols, Ptr tile, int ldt) {
+  for (int i = 0; i < rows; i++)
+    io(fd, tile + std::ptrdiff_t(i) * ldt, cols * sizeof(T),
+       off_t(sizeof header + ((row + i) * header.stride + col) * sizeof(T)));
+}
+
+// C(I, J) = sum over K of A(I, K) * B(K, J), one tile step at a time with K
+// fastest. While step s multiplies, the tiles of step s + 1 are read into
+// the other pair of buffers. A row band of C is final after its last step,
+// so the checksum reads the bands back in order.
+template <typename T>
+void S21BasicMatrix<T>::ProductOutOfCore(const std::string &lhs,
+                                         const std::string &rhs,
+                                         const std::string &result,
+                                         std::size_t budget) {
+  S21_PROFILE_SCOPE(ProductOutOfCore);
+  S21Fd aFile(Open(lhs, O_RDONLY)), bFile(Open(rhs, O_RDONLY));
+  const S21FileHeader a = ReadHeader<T>(aFile.fd, lhs),
+                      b = ReadHeader<T>(bFile.fd, rhs);
+  if (a.cols != b.rows) throw std::invalid_argument("Invalid sizes");
+  const int m = int(a.rows), n = int(b.cols), k = int(a.cols);
+  const int edge = int(std::sqrt(budget / (5.0 * sizeof(T)))) / kLane * kLane;
+  const int tile = std::min(std::max(edge, kLane), std::max({m, n, k}));
+  const int tiles[3] = {(m + tile - 1) / tile, (n + tile - 1) / tile,
+                        (k + tile - 1) / tile};
+  const long steps = long(tiles[0]) * tiles[1] * tiles[2];
+
+  S21FileHeader header = NewHeader<T>(m, n, (n + kLane - 1) / kLane * kLane);
+  const off_t row = off_t(header.stride * sizeof(T));
+  S21NewFile cFile(result);
+  if (::ftruncate(cFile.fd, off_t(sizeof header) + m * row))
+    throw std::runtime_error("Can't write file");
+
+  S21BasicMatrix c(tile, tile), aTile[2] = {c, c}, bTile[2] = {c, c};
+  auto at = [&](long s, int &i, int &j, int &p) {
+    i = int(s / tiles[2] / tiles[1]) * tile;
+    j = int(s / tiles[2] % tiles[1]) * tile, p = int(s % tiles[2]) * tile;
+  };
+  auto load = [&](long s) {
+    int i, j, p;
+    at(s, i, j, p);
+    const int mc = std::min(tile, m - i), nc = std::min(tile, n - j),
+              kc = std::min(tile, k - p);
+    const S21BasicMatrix &x = aTile[s % 2], &y = bTile[s % 2];
+    TileIo<T>(ReadAll, aFile.fd, a, i, p, mc, kc, x.matrix_, x.stride_);
+    TileIo<T>(ReadAll, bFile.fd, b, p, j, kc, nc, y.matrix_, y.stride_);
+  };
+
+  load(0);
+  for (long s = 0; s < steps; s++) {
+    std::future<void> next;
+    if (s + 1 < steps) next = std::async(std::launch::async, load, s + 1);
+    int i, j, p;
+    at(s, i, j, p);
+    const int mc = std::min(tile, m - i), nc = std::min(tile, n - j);
+    const S21BasicMatrix &x = aTile[s % 2], &y = bTile[s % 2];
+    S21Gemm(mc, nc, std::min(tile, k - p), x.matrix_, x.stride_, y.matrix_,
+            y.stride_, c.matrix_, c.stride_);
+    if (p + tile < k) {
+      if (next.valid()) next.get();
+      continue;
+    }
+    TileIo<T>(WriteAll, cFile.fd, header, i, j, mc, nc,
+              static_cast<const T *>(c.matrix_), c.stride_);
+    if (j + tile >= n) {
+      // c doubles as the read-back buffer once its last tile is written
+      const std::size_t bytes = std::size_t(mc * row);
+      for (std::size_t done = 0; done < bytes; done += c.Bytes()) {
+        const std::size_t chunk = std::min(c.Bytes(), bytes - done);
+        ReadAll(cFile.fd, c.matrix_, chunk,
+                off_t(sizeof header) + i * row + off_t(done));
+        header.checksum = Checksum(header.checksum, c.matrix_, chunk);
+      }
+    }
+    std::fill_n(c.matrix_, std::size_t(tile) * c.stride_, T());
+    if (next.valid()) next.get();
+  }
+  WriteAll(cFile.fd, &header, sizeof header, 0);
+  cFile.Commit();
+}
+
+#define INSTANTIATE(T)                                               \
+  template void S21BasicMatrix<T>::Save(const std::string &) const;  \
+  template S21BasicMatrix<T> S21BasicMatrix<T>::OpenMapped(          \
+      const std::string &, S21MapMode, bool);                        \
+  template void S21BasicMatrix<T>::ProductOutOfCore(                 \
+      const std::string &, const std::string &, const std::string &, \
+      std::size_t);
+S21_ELEMENT_TYPES(INSTANTIATE)
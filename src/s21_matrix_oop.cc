@@ -1,195 +1,552 @@
 #include "s21_matrix_oop.h"
 
+#include <utility>
+
+#include "s21_gemm.h"
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+
+#define TMPL template <typename T>
+#define MAT S21BasicMatrix<T>
+// columns per panel of the blocked LU
+#define LU_BLOCK 64
+
 //=================   CONSTRUCTORS   ======================
 
-S21Matrix::S21Matrix() : rows_{}, cols_{}, matrix_{} {}
+TMPL MAT::S21BasicMatrix() : rows_{}, cols_{}, stride_{}, matrix_{} {}
 
-S21Matrix::S21Matrix(int rows, int cols) {
+TMPL MAT::S21BasicMatrix(int rows, int cols) {
   if (rows < 1 || cols < 1) throw std::invalid_argument("Can't be less than 1");
   rows_ = rows, cols_ = cols, InitMatrix();
 }
 
-S21Matrix::S21Matrix(const S21Matrix &other)
+TMPL MAT::S21BasicMatrix(const S21BasicMatrix &other)
     : rows_(other.rows_), cols_(other.cols_) {
   if (&other == this) throw std::logic_error("Can't copy into itself");
   CopyMatrix(other);
 }
 
-S21Matrix::S21Matrix(S21Matrix &&other) {
-  matrix_ = other.matrix_, rows_ = other.rows_, cols_ = other.cols_;
-  other.matrix_ = nullptr, other.cols_ = 0, other.rows_ = 0;
+TMPL MAT::S21BasicMatrix(S21BasicMatrix &&other) noexcept : S21BasicMatrix() {
+  *this = std::move(other);
 }
 
-S21Matrix::~S21Matrix() { ClearMatrix(); }
+TMPL MAT::S21BasicMatrix(S21BasicMatrixView<const T> view) : S21BasicMatrix() {
+  if (!view.GetRows() || !view.GetCols()) return;
+  rows_ = view.GetRows(), cols_ = view.GetCols(), Allocate();
+  Block(0, 0, rows_, cols_).Assign(view);
+}
+
+TMPL MAT::~S21BasicMatrix() { ClearMatrix(); }
 
 //=================   GET/SET   ======================
 
-int S21Matrix::GetRows() const { return rows_; }
-int S21Matrix::GetCols() const { return cols_; }
+TMPL int MAT::GetRows() const { return rows_; }
+TMPL int MAT::GetCols() const { return cols_; }
 
-void S21Matrix::SetRows(int rows) {
-  S21Matrix newMatrix(rows, cols_);
+TMPL void MAT::SetRows(int rows) {
+  S21_PROFILE_SCOPE(SetRows);
+  S21BasicMatrix newMatrix(rows, cols_);
   FillMatrix(newMatrix, (rows < rows_) ? rows : rows_, cols_);
-  *this = newMatrix;
+  *this = std::move(newMatrix);
 }
 
-void S21Matrix::SetCols(int cols) {
-  S21Matrix newMatrix(rows_, cols);
+TMPL void MAT::SetCols(int cols) {
+  S21_PROFILE_SCOPE(SetCols);
+  S21BasicMatrix newMatrix(rows_, cols);
   FillMatrix(newMatrix, rows_, (cols < cols_) ? cols : cols_);
-  *this = newMatrix;
+  *this = std::move(newMatrix);
 }
 
 //=================   BASIC METHODS   ======================
 
-void S21Matrix::InitMatrix() {
-  matrix_ = new double *[rows_]();
-  FOR(rows_) matrix_[i] = new double[cols_]();
+TMPL void MAT::Allocate() {
+  stride_ = (cols_ + kLane - 1) / kLane * kLane;
+  matrix_ = static_cast<T *>(
+      ::operator new(Bytes(), std::align_val_t(kAlign)));
+  S21_PROFILE_ALLOCATION(Bytes());
+  // zeroed padding keeps saved files deterministic
+  if (stride_ > cols_)
+    FOR(rows_) std::fill(RowPtr(i) + cols_, RowPtr(i + 1), T());
+}
+
+TMPL void MAT::InitMatrix() {
+  S21_PROFILE_SCOPE(InitMatrix);
+  Allocate(), std::fill_n(matrix_, std::size_t(rows_) * stride_, T());
 }
 
-void S21Matrix::CopyMatrix(const S21Matrix &other) {
-  InitMatrix();
-  FORJ(rows_, cols_) matrix_[i][j] = other.matrix_[i][j];
+TMPL void MAT::CopyMatrix(const MAT &other) {
+  S21_PROFILE_SCOPE(CopyMatrix);
+  Allocate();
+  if (Bytes()) std::memcpy(matrix_, other.matrix_, Bytes());
 }
 
-void S21Matrix::FillMatrix(S21Matrix &newMatrix, int rows, int cols) {
-  FORJ(rows, cols) newMatrix.matrix_[i][j] = matrix_[i][j];
+TMPL void MAT::FillMatrix(MAT &newMatrix, int rows, int cols) {
+  S21_PROFILE_SCOPE(FillMatrix);
+  newMatrix.Block(0, 0, rows, cols)
+      .Assign(std::as_const(*this).Block(0, 0, rows, cols));
 }
 
-void S21Matrix::ClearMatrix() {
-  if (matrix_) FOR(rows_) delete[] matrix_[i];
-  delete[] matrix_, matrix_ = nullptr, rows_ = 0, cols_ = 0;
+TMPL void MAT::ClearMatrix() {
+  S21_PROFILE_SCOPE(ClearMatrix);
+  if (mapping_) {
+    mapping_.reset(), readOnly_ = false;
+  } else if (matrix_) {
+    S21_PROFILE_FREE(Bytes());
+    ::operator delete(matrix_, std::align_val_t(kAlign));
+  }
+  matrix_ = nullptr, rows_ = 0, cols_ = 0, stride_ = 0;
 }
 
-void S21Matrix::CheckSizes(const S21Matrix &other) const {
+TMPL void MAT::CheckSizes(const MAT &other) const {
   if (rows_ != other.rows_ || cols_ != other.cols_)
     throw std::invalid_argument("Unequal size of matrices");
 }
 
 //=================   ARITHMETIC   ======================
 
-bool S21Matrix::EqMatrix(const S21Matrix &other) const {
+TMPL bool MAT::EqMatrix(const MAT &other) const {
+  S21_PROFILE_SCOPE(EqMatrix);
   if (rows_ != other.rows_ || cols_ != other.cols_) return false;
-  FORJ(rows_, cols_)
-  if (fabs(matrix_[i][j] - other.matrix_[i][j]) >= EPS) return false;
+  const S21Kernels<T> &kernels = S21GetKernels<T>();
+  std::atomic<bool> equal{true};
+  S21ParallelRows(0, rows_, cols_, [&](int from, int to) {
+    for (int i = from; i < to && equal.load(std::memory_order_relaxed); ++i)
+      if (!kernels.equal(cols_, RowPtr(i), other.RowPtr(i), S21Traits<T>::kEps))
+        equal.store(false, std::memory_order_relaxed);
+  });
+  return equal;
+}
 
-  return true;
+#define SUMSUB(kernel)                                           \
+  CheckSizes(other);                                             \
+  Detach();                                                      \
+  S21ParallelRows(0, rows_, cols_, [&](int from, int to) {       \
+    for (int i = from; i < to; ++i)                              \
+      S21GetKernels<T>().kernel(cols_, RowPtr(i), other.RowPtr(i)); \
+  });
+
+TMPL void MAT::SumMatrix(const MAT &other) {
+  S21_PROFILE_SCOPE(SumMatrix);
+  SUMSUB(add)
+}
+TMPL void MAT::SubMatrix(const MAT &other) {
+  S21_PROFILE_SCOPE(SubMatrix);
+  SUMSUB(sub)
 }
 
-#define SUMSUB(s)    \
-  CheckSizes(other); \
-  FORJ(rows_, cols_) matrix_[i][j] s other.matrix_[i][j];
+TMPL void MAT::MulNumber(const T num) {
+  S21_PROFILE_SCOPE(MulNumber);
+  Detach();
+  S21ParallelRows(0, rows_, cols_, [&](int from, int to) {
+    for (int i = from; i < to; ++i)
+      S21GetKernels<T>().scale(cols_, RowPtr(i), num);
+  });
+}
 
-void S21Matrix::SumMatrix(const S21Matrix &other) { SUMSUB(+=) }
-void S21Matrix::SubMatrix(const S21Matrix &other) { SUMSUB(-=) }
+TMPL void MAT::MulMatrix(const MAT &other) {
+  S21_PROFILE_SCOPE(MulMatrix);
+  *this = Product(*this, other);
+}
+
+TMPL bool MAT::EqMatrix(S21BasicMatrixView<const T> other) const {
+  S21_PROFILE_SCOPE(EqMatrix);
+  return Block(0, 0, rows_, cols_).EqMatrix(other);
+}
 
-void S21Matrix::MulNumber(const double num) {
-  FORJ(rows_, cols_) matrix_[i][j] *= num;
+TMPL void MAT::SumMatrix(S21BasicMatrixView<const T> other) {
+  S21_PROFILE_SCOPE(SumMatrix);
+  Block(0, 0, rows_, cols_).SumMatrix(other);
 }
 
-void S21Matrix::MulMatrix(const S21Matrix &other) {
-  if (cols_ != other.rows_) throw std::invalid_argument("Invalid sizes");
+TMPL void MAT::SubMatrix(S21BasicMatrixView<const T> other) {
+  S21_PROFILE_SCOPE(SubMatrix);
+  Block(0, 0, rows_, cols_).SubMatrix(other);
+}
 
-  S21Matrix result(rows_, other.cols_);
-  FORJK(rows_, cols_, other.cols_)
-  result(i, k) += matrix_[i][j] * other.matrix_[j][k];
-  *this = result;
+TMPL void MAT::MulMatrix(S21BasicMatrixView<const T> other) {
+  S21_PROFILE_SCOPE(MulMatrix);
+  *this = Product(*this, other);
 }
 
 //=================   OPERATIONS   ======================
 
-S21Matrix S21Matrix::Transpose() const {
-  S21Matrix result(cols_, rows_);
-  FORJ(result.rows_, result.cols_) result.matrix_[i][j] = matrix_[j][i];
+// TILE x TILE blocks keep one source and one destination tile in L1
+#define TILE 32
+
+TMPL MAT MAT::Transpose() const {
+  S21_PROFILE_SCOPE(Transpose);
+  S21BasicMatrix result;
+  result.rows_ = cols_, result.cols_ = rows_, result.Allocate();
+  const S21Kernels<T> &kernels = S21GetKernels<T>();
+  const int tiles = (cols_ + TILE - 1) / TILE;
+  S21ParallelRows(0, tiles, TILE * rows_, [&](int from, int to) {
+    for (int j = from * TILE; j < std::min(cols_, to * TILE); j += TILE)
+      for (int i = 0; i < rows_; i += TILE)
+        kernels.transpose(std::min(TILE, rows_ - i), std::min(TILE, cols_ - j),
+                          RowPtr(i) + j, stride_, result.RowPtr(j) + i,
+                          result.stride_);
+  });
   return result;
 }
 
-S21Matrix S21Matrix::CalcComplements() const {
+// Tile (i, j) and tile (j, i) trade places through one stack tile.
+TMPL void MAT::TransposeInPlace() {
+  S21_PROFILE_SCOPE(TransposeInPlace);
+  CheckSquare();
+  Detach();
+  const S21Kernels<T> &kernels = S21GetKernels<T>();
+  const int tiles = (rows_ + TILE - 1) / TILE;
+  S21ParallelRows(0, tiles, TILE * rows_, [&](int from, int to) {
+    T tile[TILE * TILE];
+    for (int bi = from; bi < to; ++bi)
+      for (int bj = bi; bj < tiles; ++bj) {
+        const int i = bi * TILE, j = bj * TILE;
+        const int h = std::min(TILE, rows_ - i), w = std::min(TILE, cols_ - j);
+        T *upper = RowPtr(i) + j, *lower = RowPtr(j) + i;
+        kernels.transpose(h, w, upper, stride_, tile, TILE);
+        if (bi != bj) kernels.transpose(w, h, lower, stride_, upper, stride_);
+        for (int r = 0; r < w; ++r)
+          std::memcpy(lower + r * stride_, tile + r * TILE, h * sizeof(T));
+      }
+  });
+}
+
+TMPL MAT MAT::CalcComplements() const {
+  S21_PROFILE_SCOPE(CalcComplements);
   CheckSquare();
   if (rows_ == 1) throw std::logic_error("Size can not be 1");
-  S21Matrix result(rows_, cols_);
-  FindComplements(result);
+  S21BasicMatrix result(rows_, cols_);
+  // small sizes keep the exact closed-form minors, integers exact minors
+  if (S21Traits<T>::kExact || rows_ <= 4)
+    return FindComplements(result), result;
+  S21BasicMatrix lu(*this);
+  std::vector<int> pivots(rows_);
+  bool singular;
+  const T det = lu.FactorLU(pivots.data(), &singular);
+  // only a numerically rank-deficient matrix needs the complete pivoting
+  if (singular) return FindComplementsLU(result), result;
+  // cofactors of an invertible matrix are det * inverse^T
+  FOR(rows_) result.RowPtr(i)[i] = 1;
+  lu.SolveLU(pivots.data(), result);
+  result.TransposeInPlace();
+  result.MulNumber(det);
   return result;
 }
 
-double S21Matrix::Determinant() const {
+TMPL T MAT::Determinant() const {
+  S21_PROFILE_SCOPE(Determinant);
+  return Block(0, 0, rows_, cols_).Determinant();
+}
+
+TMPL MAT MAT::InverseMatrix() const {
+  S21_PROFILE_SCOPE(InverseMatrix);
   CheckSquare();
-  if (rows_ == 1) return matrix_[0][0];
-  double result = 0;
-  FOR(cols_) {
-    S21Matrix minor(rows_ - 1, cols_ - 1);
-    FindMinor(minor, 0, i);
-    result += matrix_[0][i] * pow(-1, i) * minor.Determinant();
-    minor.ClearMatrix();
+  if constexpr (S21Traits<T>::kExact) {
+    // integral only when det = +-1, and then it is det * adj
+    const T det = Determinant();
+    if (det == 0) throw std::logic_error("Determinant cannot be 0");
+    if (det != 1 && det != -1)
+      throw std::logic_error("Inverse is not integral");
+    S21BasicMatrix result(rows_, cols_);
+    result.RowPtr(0)[0] = 1;
+    if (rows_ > 1) result = CalcComplements().Transpose();
+    return result.MulNumber(det), result;
   }
+  S21BasicMatrix lu(*this), result(rows_, cols_);
+  std::vector<int> pivots(rows_);
+  bool singular;
+  lu.FactorLU(pivots.data(), &singular);
+  if (singular) throw std::logic_error("Determinant cannot be 0");
+  FOR(rows_) result.RowPtr(i)[i] = 1;
+  lu.SolveLU(pivots.data(), result);
   return result;
 }
 
-S21Matrix S21Matrix::InverseMatrix() {
-  if (fabs(Determinant()) <= EPS)
-    throw std::logic_error("Determinant cannot be 0");
-  return CalcComplements().Transpose() *= (1.0 / Determinant());
-}
-
 //=================   OPERATOR OVERLOAD   ======================
 
-#define OP S21Matrix S21Matrix::operator
-
-#define OPCOMMON(METHOD)   \
-  S21Matrix result(*this); \
-  result.METHOD;           \
-  return result
+#define OP TMPL MAT &MAT::operator
 
-OP + (const S21Matrix &other) { OPCOMMON(SumMatrix(other)); }
-OP - (const S21Matrix &other) { OPCOMMON(SubMatrix(other)); }
-OP *(const S21Matrix &other) { OPCOMMON(MulMatrix(other)); }
-OP *(const double mul) { OPCOMMON(MulNumber(mul)); }
+OP += (const S21BasicMatrix &other) { return SumMatrix(other), *this; }
+OP -= (const S21BasicMatrix &other) { return SubMatrix(other), *this; }
+OP *= (const S21BasicMatrix &other) { return MulMatrix(other), *this; }
+OP *= (const T mul) { return MulNumber(mul), *this; }
 
-OP += (const S21Matrix &other) { return SumMatrix(other), *this; }
-OP -= (const S21Matrix &other) { return SubMatrix(other), *this; }
-OP *= (const S21Matrix &other) { return MulMatrix(other), *this; }
-OP *= (const double mul) { return MulNumber(mul), *this; }
+TMPL MAT &MAT::operator=(const MAT &other) {
+  if (this == &other || Bytes() + other.Bytes() == 0) return *this;
+  if (rows_ == other.rows_ && cols_ == other.cols_ && !mapping_)
+    return std::memcpy(matrix_, other.matrix_, Bytes()), *this;
+  ClearMatrix(), rows_ = other.rows_, cols_ = other.cols_, CopyMatrix(other);
+  return *this;
+}
 
-S21Matrix &S21Matrix::operator=(const S21Matrix &other) {
+TMPL MAT &MAT::operator=(MAT &&other) noexcept {
   if (this == &other) return *this;
-  ClearMatrix(), rows_ = other.rows_, cols_ = other.cols_, CopyMatrix(other);
+  ClearMatrix();
+  std::swap(rows_, other.rows_), std::swap(cols_, other.cols_);
+  std::swap(stride_, other.stride_), std::swap(matrix_, other.matrix_);
+  mapping_.swap(other.mapping_), std::swap(readOnly_, other.readOnly_);
   return *this;
 }
 
-bool S21Matrix::operator==(const S21Matrix &other) const {
+TMPL bool MAT::operator==(const MAT &other) const {
   return EqMatrix(other);
 }
 
-double &S21Matrix::operator()(int row, int col) {
-  return CheckBounds(row, col), matrix_[row][col];
+TMPL T &MAT::operator()(int row, int col) {
+  return CheckBounds(row, col), Detach(), RowPtr(row)[col];
+}
+
+//=================   VIEWS   ======================
+
+#define VIEW(T) S21BasicMatrixView<T>
+#define WHOLE(T) VIEW(T)(matrix_, rows_, cols_, stride_)
+
+TMPL VIEW(T) MAT::Block(int row, int col, int rows, int cols) {
+  return Detach(), WHOLE(T).Block(row, col, rows, cols);
+}
+TMPL VIEW(const T) MAT::Block(int row, int col, int rows, int cols) const {
+  return WHOLE(const T).Block(row, col, rows, cols);
 }
+TMPL VIEW(T) MAT::Row(int row) { return Detach(), WHOLE(T).Row(row); }
+TMPL VIEW(const T) MAT::Row(int row) const { return WHOLE(const T).Row(row); }
+TMPL VIEW(T) MAT::Col(int col) { return Detach(), WHOLE(T).Col(col); }
+TMPL VIEW(const T) MAT::Col(int col) const { return WHOLE(const T).Col(col); }
 
 //=================   SUPPLEMENTARY   ======================
 
-void S21Matrix::CheckSquare() const {
+TMPL MAT MAT::Product(const MAT &lhs, const MAT &rhs) {
+  S21_PROFILE_SCOPE(Product);
+  if (lhs.cols_ != rhs.rows_) throw std::invalid_argument("Invalid sizes");
+
+  S21BasicMatrix result(lhs.rows_, rhs.cols_);
+  S21Gemm(lhs.rows_, rhs.cols_, lhs.cols_, lhs.matrix_, lhs.stride_,
+          rhs.matrix_, rhs.stride_, result.matrix_, result.stride_);
+  return result;
+}
+
+TMPL MAT MAT::Product(VIEW(const T) lhs, VIEW(const T) rhs) {
+  S21_PROFILE_SCOPE(Product);
+  if (lhs.GetCols() != rhs.GetRows())
+    throw std::invalid_argument("Invalid sizes");
+  S21BasicMatrix result(lhs.GetRows(), rhs.GetCols());
+  result.Block(0, 0, result.rows_, result.cols_).AddProduct(lhs, rhs);
+  return result;
+}
+
+TMPL void MAT::CheckSquare() const {
   if (rows_ != cols_) throw std::logic_error("Matrix is not square");
 }
 
-void S21Matrix::CheckBounds(int row, int col) const {
+TMPL void MAT::CheckBounds(int row, int col) const {
   if (row < 0 || col < 0)
     throw std::out_of_range("Less than 0 exception");
   else if (row >= rows_ || col >= cols_)
     throw std::out_of_range("Out of bounds exception");
 }
 
-void S21Matrix::FindMinor(S21Matrix &minor, int row, int col) const {
-  int minorRow = 0, minorCol = 0;
-  FORJ(rows_, cols_)
-  if (i != row && j != col) {
-    minor.matrix_[minorRow][minorCol++] = matrix_[i][j];
-    if (minorCol == cols_ - 1) minorCol = 0, ++minorRow;
-  }
+// the four blocks around the removed row and column
+TMPL void MAT::FindMinor(MAT &minor, int row, int col) const {
+  const int below = rows_ - row - 1, right = cols_ - col - 1;
+  minor.Block(0, 0, row, col).Assign(Block(0, 0, row, col));
+  minor.Block(0, col, row, right).Assign(Block(0, col + 1, row, right));
+  minor.Block(row, 0, below, col).Assign(Block(row + 1, 0, below, col));
+  minor.Block(row, col, below, right)
+      .Assign(Block(row + 1, col + 1, below, right));
 }
 
-void S21Matrix::FindComplements(S21Matrix &complements) const {
+TMPL void MAT::FindComplements(MAT &complements) const {
+  complements.Detach();
+  S21BasicMatrix minor(rows_ - 1, cols_ - 1);
   FORJ(rows_, cols_) {
-    S21Matrix minor(rows_ - 1, cols_ - 1);
     FindMinor(minor, i, j);
-    complements.matrix_[i][j] = pow(-1, (i + j)) * minor.Determinant();
-    minor.ClearMatrix();
+    complements.RowPtr(i)[j] = T((i + j) % 2 ? -1 : 1) * minor.Determinant();
+  }
+}
+
+// Rank-aware cofactors from one complete-pivoting LU, P * A * Q = L * U.
+// With U = [U11 u; 0 e], adj(U) = det(U11) * [e * inv(U11), -inv(U11) * u;
+// 0, 1] never divides by e, so rank n-1 input gets its exact limit, and a
+// zero pivot before the last one means rank < n-1 where every minor is 0.
+// cof(A)(r[i], c[j]) = sign * X(j, i) for X = adj(U) * inv(L); complements
+// must come in zeroed.
+TMPL void MAT::FindComplementsLU(MAT &complements) const {
+  const int n = rows_;
+  complements.Detach();
+  S21BasicMatrix lu(*this), x(n, n);
+  std::vector<int> r(n), c(n);
+  T sign = 1, det = 1;
+  FOR(n) r[i] = c[i] = i;
+  for (int k = 0; k + 1 < n; ++k) {
+    int p = k, q = k;
+    for (int i = k; i < n; ++i)
+      for (int j = k; j < n; ++j)
+        if (S21Abs(lu.RowPtr(i)[j]) > S21Abs(lu.RowPtr(p)[q])) p = i, q = j;
+    if (lu.RowPtr(p)[q] == T(0)) return;
+    if (p != k) {
+      std::swap_ranges(lu.RowPtr(k), lu.RowPtr(k) + n, lu.RowPtr(p));
+      std::swap(r[k], r[p]), sign = -sign;
+    }
+    if (q != k) {
+      FOR(n) std::swap(lu.RowPtr(i)[k], lu.RowPtr(i)[q]);
+      std::swap(c[k], c[q]), sign = -sign;
+    }
+    const T *pivot = lu.RowPtr(k);
+    det *= pivot[k];
+    S21ParallelRows(k + 1, n, n - k, [&](int from, int to) {
+      for (int i = from; i < to; ++i) {
+        T *row = lu.RowPtr(i), l = row[k] /= pivot[k];
+        for (int j = k + 1; j < n; ++j) row[j] -= l * pivot[j];
+      }
+    });
+  }
+
+  // U11 * W = [e * I, -u] by back substitution; adj(U) = det(U11) * W
+  const T e = lu.RowPtr(n - 1)[n - 1];
+  for (int i = n - 2; i >= 0; --i) {
+    T *w = x.RowPtr(i);
+    w[i] = e, w[n - 1] = -lu.RowPtr(i)[n - 1];
+    for (int k = i + 1; k < n - 1; ++k) {
+      const T u = lu.RowPtr(i)[k], *y = x.RowPtr(k);
+      for (int j = 0; j < n; ++j) w[j] -= u * y[j];
+    }
+    const T d = T(1) / lu.RowPtr(i)[i];
+    for (int j = 0; j < n; ++j) w[j] *= d;
+  }
+  x.RowPtr(n - 1)[n - 1] = 1;
+  x.MulNumber(det);
+  // X * L = adj(U), L unit lower: column k is final once k + 1.. are done
+  S21ParallelRows(0, n, n * n, [&](int from, int to) {
+    for (int i = from; i < to; ++i) {
+      T *y = x.RowPtr(i);
+      for (int k = n - 1; k > 0; --k) {
+        const T *l = lu.RowPtr(k);
+        for (int j = 0; j < k; ++j) y[j] -= y[k] * l[j];
+      }
+    }
+  });
+  FORJ(n, n) complements.RowPtr(r[i])[c[j]] = sign * x.RowPtr(j)[i];
+}
+
+// In-place partial-pivoting LU (unit L below the diagonal, U on and above).
+// Row k was swapped with pivots[k]; returns the determinant, 0 at an exact
+// zero pivot. singular, when given, is set if any pivot is negligible next
+// to the largest |entry| (S21NegligiblePivot). Right-looking in
+// LU_BLOCK-column panels: each panel is eliminated on its own columns, its
+// rows of U are solved against the unit L11, and the trailing matrix takes
+// the whole rank-LU_BLOCK update through S21Gemm.
+TMPL T MAT::FactorLU(int *pivots, bool *singular) {
+  S21_PROFILE_SCOPE(FactorLU);
+  Detach();
+  const int n = rows_;
+  typename S21Traits<T>::Real scale = 0;
+  if (singular) {
+    *singular = false;
+    FORJ(n, n) scale = std::max(scale, S21Abs(RowPtr(i)[j]));
+  }
+  S21BasicMatrix negated;  // -L21 of the current panel, the Gemm lhs
+  if (n > LU_BLOCK) negated = S21BasicMatrix(n - LU_BLOCK, LU_BLOCK);
+  T det = 1;
+  for (int k0 = 0; k0 < n; k0 += LU_BLOCK) {
+    const int end = std::min(k0 + LU_BLOCK, n);
+    for (int k = k0; k < end; ++k) {
+      int p = k;
+      for (int i = k + 1; i < n; ++i)
+        if (S21Abs(RowPtr(i)[k]) > S21Abs(RowPtr(p)[k])) p = i;
+      if (pivots) pivots[k] = p;
+      if (singular && S21NegligiblePivot(RowPtr(p)[k], n, scale))
+        *singular = true;
+      if (RowPtr(p)[k] == T(0)) return 0;
+      if (p != k) {
+        std::swap_ranges(RowPtr(k), RowPtr(k) + cols_, RowPtr(p));
+        det = -det;
+      }
+      const T *pivot = RowPtr(k);
+      det *= pivot[k];
+      S21ParallelRows(k + 1, n, end - k, [&](int from, int to) {
+        for (int i = from; i < to; ++i) {
+          T *row = RowPtr(i), l = row[k] /= pivot[k];
+          for (int j = k + 1; j < end; ++j) row[j] -= l * pivot[j];
+        }
+      });
+    }
+    if (end == n) break;
+    // U12 = inv(L11) * A12, row by row
+    const S21Kernels<T> &kernels = S21GetKernels<T>();
+    for (int i = k0 + 1; i < end; ++i)
+      for (int k = k0; k < i; ++k)
+        kernels.axpy(n - end, RowPtr(i) + end, RowPtr(k) + end,
+                     -RowPtr(i)[k]);
+    // A22 -= L21 * U12
+    const int nb = end - k0;
+    for (int i = end; i < n; ++i)
+      for (int j = 0; j < nb; ++j)
+        negated.RowPtr(i - end)[j] = -RowPtr(i)[k0 + j];
+    S21Gemm(n - end, n - end, nb, negated.matrix_, negated.stride_,
+            RowPtr(k0) + end, stride_, RowPtr(end) + end, stride_);
   }
-}
\ No newline at end of file
+  return det;
+}
+
+// Fraction-free (Bareiss) elimination in place: every division is exact on
+// integers and the last pivot is the determinant.
+TMPL T MAT::FactorBareiss() {
+  S21_PROFILE_SCOPE(FactorBareiss);
+  Detach();
+  T sign = 1, previous = 1;
+  for (int k = 0; k + 1 < rows_; ++k) {
+    int p = k;
+    while (p < rows_ && RowPtr(p)[k] == T(0)) ++p;
+    if (p == rows_) return 0;
+    if (p != k) {
+      std::swap_ranges(RowPtr(k), RowPtr(k) + cols_, RowPtr(p));
+      sign = -sign;
+    }
+    const T *pivot = RowPtr(k);
+    S21ParallelRows(k + 1, rows_, cols_ - k, [&](int from, int to) {
+      for (int i = from; i < to; ++i) {
+        T *row = RowPtr(i);
+        for (int j = k + 1; j < cols_; ++j)
+          row[j] = (row[j] * pivot[k] - row[k] * pivot[j]) / previous;
+        row[k] = 0;
+      }
+    });
+    previous = pivot[k];
+  }
+  return sign * RowPtr(rows_ - 1)[rows_ - 1];
+}
+
+// Overwrites rhs with the solution of A * X = rhs, *this holding FactorLU(A).
+// Columns of rhs are independent, so the pool takes them in blocks.
+TMPL void MAT::SolveLU(const int *pivots, MAT &rhs) const {
+  S21_PROFILE_SCOPE(SolveLU);
+  rhs.Detach();
+  const int n = rows_;
+  S21ParallelRows(0, rhs.cols_, n * n, [&](int from, int to) {
+    const int m = to - from;
+    FOR(n) if (pivots[i] != i) {
+      T *x = rhs.RowPtr(i) + from;
+      std::swap_ranges(x, x + m, rhs.RowPtr(pivots[i]) + from);
+    }
+    for (int i = 1; i < n; ++i) {
+      T *x = rhs.RowPtr(i) + from;
+      for (int k = 0; k < i; ++k) {
+        const T l = RowPtr(i)[k], *y = rhs.RowPtr(k) + from;
+        if (l != T(0))
+          for (int j = 0; j < m; ++j) x[j] -= l * y[j];
+      }
+    }
+    for (int i = n - 1; i >= 0; --i) {
+      T *x = rhs.RowPtr(i) + from;
+      for (int k = i + 1; k < n; ++k) {
+        const T u = RowPtr(i)[k], *y = rhs.RowPtr(k) + from;
+        if (u != T(0))
+          for (int j = 0; j < m; ++j) x[j] -= u * y[j];
+      }
+      const T d = T(1) / RowPtr(i)[i];
+      for (int j = 0; j < m; ++j) x[j] *= d;
+    }
+  });
+}
+
+#define INSTANTIATE(T) template class S21BasicMatrix<T>;
+S21_ELEMENT_TYPES(INSTANTIATE)
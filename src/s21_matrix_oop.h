@@ -1,22 +1,75 @@
 #ifndef S21_MATRIX_OOP_H
 #define S21_MATRIX_OOP_H
 
+#include <algorithm>
 #include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
-#define EPS 1.0e-7
+#include "s21_profile.h"
+#include "s21_traits.h"
+
+// tolerance of the double instantiation, kept for existing callers
+#define EPS (S21Traits<double>::kEps)
 #define FOR(x) for (int i = 0; i < x; i++)
 #define FORJ(x, y) FOR(x) for (int j = 0; j < y; j++)
 #define FORJK(x, y, z) FORJ(x, y) for (int k = 0; k < z; k++)
 
-class S21Matrix {
+template <typename E>
+class S21Expr;
+template <typename T, bool Owned>
+class S21MatrixRef;
+template <int R, int C>
+class S21FixedMatrix;
+template <typename T>
+class S21BasicSparseMatrix;
+template <typename T>
+class S21BasicMatrixView;
+template <typename T>
+class S21BasicVector;
+template <typename T>
+class S21BasicQR;
+template <typename T>
+class S21BasicSymmetricEigen;
+
+// how OpenMapped shares the file: kS21ReadOnly maps its pages read-only and
+// the first call that may write the matrix (a mutator, operator() or a
+// writable view) copies it into memory of its own, ending earlier views as
+// a reassignment would; kS21CopyOnWrite gives the process private copies of
+// just the pages it writes
+enum S21MapMode { kS21ReadOnly, kS21CopyOnWrite };
+
+// default memory for the tiles of one out-of-core product
+#define S21_TILE_BUDGET (std::size_t(1) << 30)
+
+// Dense row-major matrix of any type in S21_ELEMENT_TYPES. Integers are
+// exact: Determinant and CalcComplements are fraction-free and
+// InverseMatrix only succeeds when the inverse is integral too.
+template <typename T>
+class S21BasicMatrix {
  public:
+  using Scalar = T;
+
   //=================  CONSTRUCTORS   ======================
-  S21Matrix();
-  S21Matrix(int rows, int cols);
-  S21Matrix(const S21Matrix& other);
-  S21Matrix(S21Matrix&& other);
-  ~S21Matrix();
+  S21BasicMatrix();
+  S21BasicMatrix(int rows, int cols);
+  S21BasicMatrix(const S21BasicMatrix& other);
+  S21BasicMatrix(S21BasicMatrix&& other) noexcept;
+  template <typename E>
+  S21BasicMatrix(const S21Expr<E>& expr);
+  template <typename E>
+  S21BasicMatrix(S21Expr<E>&& expr);
+  // compact copy of the viewed elements
+  explicit S21BasicMatrix(S21BasicMatrixView<const T> view);
+  ~S21BasicMatrix();
 
   //=================   GET/SET   ======================
   int GetRows() const;
@@ -25,47 +78,144 @@ class S21Matrix {
   void SetCols(int cols);
 
   //=================   ARITHMETIC   ======================
-  bool EqMatrix(const S21Matrix& other) const;
-  void SumMatrix(const S21Matrix& other);
-  void SubMatrix(const S21Matrix& other);
-  void MulNumber(const double num);
-  void MulMatrix(const S21Matrix& other);
+  bool EqMatrix(const S21BasicMatrix& other) const;
+  void SumMatrix(const S21BasicMatrix& other);
+  void SubMatrix(const S21BasicMatrix& other);
+  void MulNumber(const T num);
+  void MulMatrix(const S21BasicMatrix& other);
+  // the same with any view as the other operand, read in place
+  bool EqMatrix(S21BasicMatrixView<const T> other) const;
+  void SumMatrix(S21BasicMatrixView<const T> other);
+  void SubMatrix(S21BasicMatrixView<const T> other);
+  void MulMatrix(S21BasicMatrixView<const T> other);
 
   //=================   OPERATIONS   ======================
-  double Determinant() const;
-  S21Matrix Transpose() const;
-  S21Matrix CalcComplements() const;
-  S21Matrix InverseMatrix();
+  T Determinant() const;
+  S21BasicMatrix Transpose() const;
+  void TransposeInPlace();
+  S21BasicMatrix CalcComplements() const;
+  S21BasicMatrix InverseMatrix() const;
 
   //=================   OPERATOR OVERLOAD   ======================
-  S21Matrix operator+(const S21Matrix& other);
-  S21Matrix operator-(const S21Matrix& other);
-  S21Matrix operator*(const S21Matrix& other);
-  S21Matrix operator*(const double mul);
-  bool operator==(const S21Matrix& other) const;
-  S21Matrix& operator=(const S21Matrix& other);
-  S21Matrix operator+=(const S21Matrix& other);
-  S21Matrix operator-=(const S21Matrix& other);
-  S21Matrix operator*=(const S21Matrix& other);
-  S21Matrix operator*=(const double mul);
-  double& operator()(int row, int col);
+  // +, - and * live in s21_matrix_expr.h as lazy expression builders
+  bool operator==(const S21BasicMatrix& other) const;
+  S21BasicMatrix& operator=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator=(S21BasicMatrix&& other) noexcept;
+  template <typename E>
+  S21BasicMatrix& operator=(const S21Expr<E>& expr);
+  template <typename E>
+  S21BasicMatrix& operator=(S21Expr<E>&& expr);
+  S21BasicMatrix& operator+=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator-=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator*=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator*=(const T mul);
+  template <typename E>
+  S21BasicMatrix& operator+=(const S21Expr<E>& expr);
+  template <typename E>
+  S21BasicMatrix& operator-=(const S21Expr<E>& expr);
+  T& operator()(int row, int col);
+
+  //=================   VIEWS   ======================
+  // windows onto these elements without copying, see s21_matrix_view.h
+  S21BasicMatrixView<T> Block(int row, int col, int rows, int cols);
+  S21BasicMatrixView<const T> Block(int row, int col, int rows,
+                                    int cols) const;
+  S21BasicMatrixView<T> Row(int row);
+  S21BasicMatrixView<const T> Row(int row) const;
+  S21BasicMatrixView<T> Col(int col);
+  S21BasicMatrixView<const T> Col(int col) const;
+
+  //=================   VECTORS   ======================
+  // y = A * x and y = A^T * x (transposed, not conjugated), see
+  // s21_vector.h; the forms taking y reuse its storage when it already has
+  // the right size
+  S21BasicVector<T> Mul(const S21BasicVector<T>& x) const;
+  S21BasicVector<T> MulTransposed(const S21BasicVector<T>& x) const;
+  void Mul(const S21BasicVector<T>& x, S21BasicVector<T>& y) const;
+  void MulTransposed(const S21BasicVector<T>& x, S21BasicVector<T>& y) const;
+
+  //=================   PERSISTENCE   ======================
+  // versioned binary file, laid out in s21_matrix_io.cc; a default or
+  // moved-from matrix has no file form and throws
+  void Save(const std::string& path) const;
+  // maps the file instead of reading it, so pages load on first touch;
+  // verify reads the whole payload once to check its checksum
+  static S21BasicMatrix OpenMapped(const std::string& path,
+                                   S21MapMode mode = kS21ReadOnly,
+                                   bool verify = false);
+  // result file = lhs file * rhs file without loading either: square tiles
+  // sized so that about budget bytes hold one C tile and two A and B tiles
+  // each, the next pair being read while the current one multiplies
+  static void ProductOutOfCore(const std::string& lhs, const std::string& rhs,
+                               const std::string& result,
+                               std::size_t budget = S21_TILE_BUDGET);
 
   //=================   BASIC METHODS   ======================
   void InitMatrix();
   void ClearMatrix();
-  void CopyMatrix(const S21Matrix& other);
-  void FillMatrix(S21Matrix& newMatrix, int rows, int cols);
+  void CopyMatrix(const S21BasicMatrix& other);
+  void FillMatrix(S21BasicMatrix& newMatrix, int rows, int cols);
 
   //=================   SUPPLEMENTARY   ======================
-  void CheckSizes(const S21Matrix& other) const;
+  void CheckSizes(const S21BasicMatrix& other) const;
   void CheckSquare() const;
   void CheckBounds(int row, int col) const;
-  void FindMinor(S21Matrix& minor, int row, int col) const;
-  void FindComplements(S21Matrix& complements) const;
+  void FindMinor(S21BasicMatrix& minor, int row, int col) const;
+  void FindComplements(S21BasicMatrix& complements) const;
+  void FindComplementsLU(S21BasicMatrix& complements) const;
+  T FactorLU(int* pivots, bool* singular = nullptr);
+  T FactorBareiss();
+  void SolveLU(const int* pivots, S21BasicMatrix& rhs) const;
+  void FactorCholesky();
+  void SolveCholesky(S21BasicMatrix& rhs) const;
+  static S21BasicMatrix Product(const S21BasicMatrix& lhs,
+                                const S21BasicMatrix& rhs);
+  static S21BasicMatrix Product(S21BasicMatrixView<const T> lhs,
+                                S21BasicMatrixView<const T> rhs);
 
  private:
-  int rows_, cols_;
-  double** matrix_;
+  // rows are kAlign-aligned and padded to stride_ elements in one buffer
+  static constexpr std::size_t kAlign = 64;
+  static constexpr int kLane = kAlign / sizeof(T);
+
+  template <typename U, bool Owned>
+  friend class S21MatrixRef;
+  template <int R, int C>
+  friend class S21FixedMatrix;
+  template <typename U>
+  friend class S21BasicSparseMatrix;
+  template <typename U>
+  friend class S21BasicVector;
+  template <typename U>
+  friend class S21BasicQR;
+  template <typename U>
+  friend class S21BasicSymmetricEigen;
+
+  void Allocate();
+  template <typename E, typename Op>
+  void Evaluate(const E& expr, Op op);
+  std::size_t Bytes() const { return std::size_t(rows_) * stride_ * sizeof(T); }
+  // before anything writes the elements: leaves a read-only mapping
+  void Detach() {
+    if (readOnly_) *this = S21BasicMatrix(*this);
+  }
+  T* RowPtr(int row) const { return matrix_ + std::ptrdiff_t(row) * stride_; }
+
+  int rows_, cols_, stride_;
+  T* matrix_;
+  // set while matrix_ points into a file mapping, which it then owns
+  std::shared_ptr<void> mapping_;
+  // set while that mapping is PROT_READ
+  bool readOnly_ = false;
 };
 
+using S21Matrix = S21BasicMatrix<double>;
+using S21MatrixF = S21BasicMatrix<float>;
+using S21MatrixI64 = S21BasicMatrix<std::int64_t>;
+using S21MatrixC = S21BasicMatrix<std::complex<double>>;
+
+#include "s21_matrix_expr.h"
+#include "s21_matrix_view.h"
+#include "s21_vector.h"
+
 #endif  // S21_MATRIX_OOP_H
\ No newline at end of file
@@ -0,0 +1,232 @@
+#ifndef S21_MATRIX_VIEW_H
+#define S21_MATRIX_VIEW_H
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+#include "s21_gemm.h"
+#include "s21_matrix_oop.h"
+#include "s21_simd.h"
+
+//=================   VIEWS   ======================
+// A non-owning window onto elements stored elsewhere: element (i, j) is
+// data[i * rowStride + j * colStride]. Blocks, rows, columns, strided
+// subsets and transposes of a view are views of the same storage, so
+// slicing never allocates. S21BasicMatrixView<const T> is read-only. A view
+// of an S21BasicMatrix lives until the matrix is resized, reassigned or
+// destroyed, so views of temporaries do not compile. Rows with unit column
+// stride take the vector kernels, and products of such views S21Gemm.
+
+template <typename T>
+class S21BasicMatrixView {
+ public:
+  using Scalar = std::remove_const_t<T>;
+  using ConstView = S21BasicMatrixView<const Scalar>;
+  using Owner = std::conditional_t<std::is_const_v<T>,
+                                   const S21BasicMatrix<Scalar>,
+                                   S21BasicMatrix<Scalar>>;
+
+  //=================  CONSTRUCTORS   ======================
+  S21BasicMatrixView(T* data, int rows, int cols, std::ptrdiff_t rowStride,
+                     std::ptrdiff_t colStride = 1)
+      : data_(data),
+        rows_(rows),
+        cols_(cols),
+        rowStride_(rowStride),
+        colStride_(colStride) {
+    if (rows < 0 || cols < 0)
+      throw std::invalid_argument("Can't be less than 0");
+  }
+  S21BasicMatrixView(Owner& matrix)
+      : S21BasicMatrixView(matrix.Block(0, 0, matrix.GetRows(),
+                                        matrix.GetCols())) {}
+  S21BasicMatrixView(S21BasicMatrix<Scalar>&& matrix) = delete;
+  // a writable view reads as a read-only one
+  template <typename U, typename = std::enable_if_t<
+                            std::is_same_v<const U, T> && !std::is_const_v<U>>>
+  S21BasicMatrixView(const S21BasicMatrixView<U>& other)
+      : S21BasicMatrixView(other.data_, other.rows_, other.cols_,
+                           other.rowStride_, other.colStride_) {}
+
+  //=================   GET   ======================
+  int GetRows() const { return rows_; }
+  int GetCols() const { return cols_; }
+  std::ptrdiff_t GetRowStride() const { return rowStride_; }
+  std::ptrdiff_t GetColStride() const { return colStride_; }
+  T* Data() const { return data_; }
+
+  //=================   SLICING   ======================
+  S21BasicMatrixView Block(int row, int col, int rows, int cols) const {
+    if (row < 0 || col < 0 || rows < 0 || cols < 0 || row + rows > rows_ ||
+        col + cols > cols_)
+      throw std::out_of_range("Out of bounds exception");
+    return S21BasicMatrixView(rows && cols ? At(row, col) : data_, rows, cols,
+                              rowStride_, colStride_);
+  }
+  S21BasicMatrixView Row(int row) const { return Block(row, 0, 1, cols_); }
+  S21BasicMatrixView Col(int col) const { return Block(0, col, rows_, 1); }
+  // every rowStep-th row and colStep-th column, starting from (0, 0)
+  S21BasicMatrixView Strided(int rowStep, int colStep) const {
+    if (rowStep < 1 || colStep < 1)
+      throw std::invalid_argument("Can't be less than 1");
+    return S21BasicMatrixView(data_, (rows_ + rowStep - 1) / rowStep,
+                              (cols_ + colStep - 1) / colStep,
+                              rowStride_ * rowStep, colStride_ * colStep);
+  }
+  S21BasicMatrixView Transposed() const {
+    return S21BasicMatrixView(data_, cols_, rows_, colStride_, rowStride_);
+  }
+
+  //=================   ARITHMETIC   ======================
+  // in place on the viewed elements; other must not overlap them unless
+  // it views exactly the same ones
+  bool EqMatrix(ConstView other) const;
+  void SumMatrix(ConstView other) {
+    Apply(other, &S21Kernels<Scalar>::add, [](T& x, Scalar y) { x += y; });
+  }
+  void SubMatrix(ConstView other) {
+    Apply(other, &S21Kernels<Scalar>::sub, [](T& x, Scalar y) { x -= y; });
+  }
+  void MulNumber(const Scalar num);
+  void Assign(ConstView other) {
+    Apply(other, nullptr, [](T& x, Scalar y) { x = y; });
+  }
+  void Fill(const Scalar value) {
+    FOR(rows_) for (int j = 0; j < cols_; j++) *At(i, j) = value;
+  }
+  // this += lhs * rhs without allocating; neither may overlap this
+  void AddProduct(ConstView lhs, ConstView rhs);
+
+  //=================   OPERATIONS   ======================
+  // closed forms up to 3 x 3, one compact copy to factor beyond
+  Scalar Determinant() const;
+  S21BasicMatrix<Scalar> Transpose() const {
+    return S21BasicMatrix<Scalar>(Transposed());
+  }
+
+  //=================   OPERATOR OVERLOAD   ======================
+  T& operator()(int row, int col) const {
+    if (row < 0 || col < 0)
+      throw std::out_of_range("Less than 0 exception");
+    else if (row >= rows_ || col >= cols_)
+      throw std::out_of_range("Out of bounds exception");
+    return *At(row, col);
+  }
+  bool operator==(ConstView other) const { return EqMatrix(other); }
+  S21BasicMatrixView& operator+=(ConstView other) {
+    return SumMatrix(other), *this;
+  }
+  S21BasicMatrixView& operator-=(ConstView other) {
+    return SubMatrix(other), *this;
+  }
+  S21BasicMatrixView& operator*=(const Scalar mul) {
+    return MulNumber(mul), *this;
+  }
+
+  //=================   SUPPLEMENTARY   ======================
+  void CheckSizes(ConstView other) const {
+    if (rows_ != other.rows_ || cols_ != other.cols_)
+      throw std::invalid_argument("Unequal size of matrices");
+  }
+
+ private:
+  template <typename U>
+  friend class S21BasicMatrixView;
+
+  T* At(int row, int col) const {
+    return data_ + row * rowStride_ + col * colStride_;
+  }
+  // kernel, or a copy for nullptr, on whole rows when both sides have unit
+  // column stride; op element by element otherwise
+  template <typename K, typename F>
+  void Apply(ConstView other, K kernel, F op);
+
+  T* data_;
+  int rows_, cols_;
+  std::ptrdiff_t rowStride_, colStride_;
+};
+
+using S21MatrixView = S21BasicMatrixView<double>;
+using S21ConstMatrixView = S21BasicMatrixView<const double>;
+
+template <typename T>
+bool S21BasicMatrixView<T>::EqMatrix(ConstView other) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_) return false;
+  const bool rows = colStride_ == 1 && other.colStride_ == 1;
+  FOR(rows_) {
+    if (rows) {
+      if (!S21GetKernels<Scalar>().equal(cols_, At(i, 0), other.At(i, 0),
+                                         S21Traits<Scalar>::kEps))
+        return false;
+    } else {
+      for (int j = 0; j < cols_; j++)
+        if (!S21Near<Scalar>(*At(i, j), *other.At(i, j))) return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+typename S21BasicMatrixView<T>::Scalar S21BasicMatrixView<T>::Determinant()
+    const {
+  if (rows_ != cols_) throw std::logic_error("Matrix is not square");
+  auto a = [&](int i, int j) { return *At(i, j); };
+  if (rows_ == 1) return a(0, 0);
+  if (rows_ == 2) return a(0, 0) * a(1, 1) - a(0, 1) * a(1, 0);
+  if (rows_ == 3)
+    return a(0, 0) * (a(1, 1) * a(2, 2) - a(1, 2) * a(2, 1)) -
+           a(0, 1) * (a(1, 0) * a(2, 2) - a(1, 2) * a(2, 0)) +
+           a(0, 2) * (a(1, 0) * a(2, 1) - a(1, 1) * a(2, 0));
+  S21BasicMatrix<Scalar> lu(*this);
+  if constexpr (S21Traits<Scalar>::kExact)
+    return lu.FactorBareiss();
+  else
+    return lu.FactorLU(nullptr);
+}
+
+// S21Gemm when every side has unit column stride, so blocks of a matrix
+// multiply at full speed; a plain loop over transposed or strided ones
+template <typename T>
+void S21BasicMatrixView<T>::AddProduct(ConstView lhs, ConstView rhs) {
+  if (lhs.cols_ != rhs.rows_ || rows_ != lhs.rows_ || cols_ != rhs.cols_)
+    throw std::invalid_argument("Invalid sizes");
+  if (!rows_ || !cols_ || !lhs.cols_) return;
+  if (colStride_ == 1 && lhs.colStride_ == 1 && rhs.colStride_ == 1) {
+    S21Gemm(rows_, cols_, lhs.cols_, lhs.data_, int(lhs.rowStride_),
+            rhs.data_, int(rhs.rowStride_), data_, int(rowStride_));
+    return;
+  }
+  FOR(rows_) for (int p = 0; p < lhs.cols_; p++) {
+    const Scalar x = *lhs.At(i, p);
+    for (int j = 0; j < cols_; j++) *At(i, j) += x * *rhs.At(p, j);
+  }
+}
+
+template <typename T>
+void S21BasicMatrixView<T>::MulNumber(const Scalar num) {
+  FOR(rows_) {
+    if (colStride_ == 1)
+      S21GetKernels<Scalar>().scale(cols_, At(i, 0), num);
+    else
+      for (int j = 0; j < cols_; j++) *At(i, j) *= num;
+  }
+}
+
+template <typename T>
+template <typename K, typename F>
+void S21BasicMatrixView<T>::Apply(ConstView other, K kernel, F op) {
+  CheckSizes(other);
+  const bool rows = colStride_ == 1 && other.colStride_ == 1;
+  FOR(rows_) {
+    if (!rows)
+      for (int j = 0; j < cols_; j++) op(*At(i, j), *other.At(i, j));
+    else if constexpr (std::is_same_v<K, std::nullptr_t>)
+      std::copy_n(other.At(i, 0), cols_, At(i, 0));
+    else
+      (S21GetKernels<Scalar>().*kernel)(cols_, At(i, 0), other.At(i, 0));
+  }
+}
+
+#endif  // S21_MATRIX_VIEW_H
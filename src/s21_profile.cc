@@ -0,0 +1,140 @@
+#include "s21_profile.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+struct MethodCounters {
+  std::atomic<std::uint64_t> calls{0}, nanoseconds{0};
+};
+
+// one complete trace event, in nanoseconds of the steady clock
+struct TraceEvent {
+  S21ProfiledMethod method;
+  int thread;
+  std::int64_t start, duration;
+};
+
+static MethodCounters methodCounters[kS21ProfiledMethods];
+static std::atomic<std::uint64_t> allocations{0}, frees{0}, bytesAllocated{0},
+    bytesFreed{0}, peakBytes{0};
+static std::atomic<bool> tracing{false};
+static std::mutex traceMutex;
+static std::vector<TraceEvent> traceEvents;
+static std::atomic<int> nextThread{0};
+// a small id per thread for the trace's tid
+static thread_local int tThread = nextThread++;
+
+static std::int64_t Now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+#define S21_PROFILE_NAME(name) #name,
+static const char* const kMethodNames[] = {
+    S21_PROFILED_METHODS(S21_PROFILE_NAME)};
+#undef S21_PROFILE_NAME
+
+const char* S21ProfiledMethodName(S21ProfiledMethod method) {
+  return kMethodNames[method];
+}
+
+//=================   HOOKS   ======================
+
+S21ProfileScope::S21ProfileScope(S21ProfiledMethod method)
+    : method_(method), start_(Now()) {}
+
+S21ProfileScope::~S21ProfileScope() {
+  const std::int64_t duration = Now() - start_;
+  MethodCounters& counters = methodCounters[method_];
+  counters.calls.fetch_add(1, std::memory_order_relaxed);
+  counters.nanoseconds.fetch_add(duration, std::memory_order_relaxed);
+  if (!tracing.load(std::memory_order_relaxed)) return;
+  const std::lock_guard<std::mutex> lock(traceMutex);
+  traceEvents.push_back({method_, tThread, start_, duration});
+}
+
+void S21ProfileAllocation(std::size_t bytes) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  const std::uint64_t held =
+      bytesAllocated.fetch_add(bytes, std::memory_order_relaxed) + bytes -
+      bytesFreed.load(std::memory_order_relaxed);
+  std::uint64_t peak = peakBytes.load(std::memory_order_relaxed);
+  // frees of blocks allocated before a reset can outnumber the allocations
+  while (std::int64_t(held) > std::int64_t(peak) &&
+         !peakBytes.compare_exchange_weak(peak, held,
+                                          std::memory_order_relaxed)) {
+  }
+}
+
+void S21ProfileFree(std::size_t bytes) {
+  frees.fetch_add(1, std::memory_order_relaxed);
+  bytesFreed.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+//=================   SNAPSHOTS   ======================
+
+S21ProfileSnapshot S21GetProfile() {
+  S21ProfileSnapshot snapshot{};
+  for (int i = 0; i < kS21ProfiledMethods; ++i)
+    snapshot.methods[i] = {methodCounters[i].calls.load(),
+                           methodCounters[i].nanoseconds.load()};
+  snapshot.allocations = allocations, snapshot.frees = frees;
+  snapshot.bytes_allocated = bytesAllocated, snapshot.bytes_freed = bytesFreed;
+  snapshot.peak_bytes = peakBytes;
+  return snapshot;
+}
+
+void S21ResetProfile() {
+  for (MethodCounters& counters : methodCounters)
+    counters.calls = 0, counters.nanoseconds = 0;
+  allocations = 0, frees = 0, bytesAllocated = 0, bytesFreed = 0;
+  peakBytes = 0;
+  const std::lock_guard<std::mutex> lock(traceMutex);
+  traceEvents.clear();
+}
+
+void S21WriteProfileJson(const S21ProfileSnapshot& snapshot,
+                         std::ostream& out) {
+  out << "{\"methods\":{";
+  const char* separator = "";
+  for (int i = 0; i < kS21ProfiledMethods; ++i) {
+    const S21ProfileCounts& counts = snapshot.methods[i];
+    if (!counts.calls) continue;
+    out << separator << '"' << kMethodNames[i] << "\":{\"calls\":"
+        << counts.calls << ",\"ns\":" << counts.nanoseconds << '}';
+    separator = ",";
+  }
+  out << "},\"allocations\":" << snapshot.allocations
+      << ",\"frees\":" << snapshot.frees
+      << ",\"bytes_allocated\":" << snapshot.bytes_allocated
+      << ",\"bytes_freed\":" << snapshot.bytes_freed
+      << ",\"peak_bytes\":" << snapshot.peak_bytes << '}';
+}
+
+//=================   TRACING   ======================
+
+void S21SetTracing(bool on) { tracing = on; }
+
+// timestamps in microseconds, as the format wants, with nanosecond digits
+void S21WriteTrace(std::ostream& out) {
+  const std::lock_guard<std::mutex> lock(traceMutex);
+  auto micros = [&](std::int64_t ns) -> std::ostream& {
+    return out << ns / 1000 << '.' << char('0' + ns / 100 % 10)
+               << char('0' + ns / 10 % 10) << char('0' + ns % 10);
+  };
+  out << "{\"traceEvents\":[";
+  const char* separator = "";
+  for (const TraceEvent& event : traceEvents) {
+    out << separator << "{\"name\":\"" << kMethodNames[event.method]
+        << "\",\"cat\":\"s21_matrix\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+        << event.thread << ",\"ts\":";
+    micros(event.start) << ",\"dur\":";
+    micros(event.duration) << '}';
+    separator = ",";
+  }
+  out << "],\"displayTimeUnit\":\"ns\"}";
+}
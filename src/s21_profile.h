@@ -0,0 +1,95 @@
+#ifndef S21_PROFILE_H
+#define S21_PROFILE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+//=================   INSTRUMENTATION   ======================
+// Calls and wall time of the S21BasicMatrix methods below, summed over
+// every element type, plus the heap allocations of Allocate (InitMatrix,
+// CopyMatrix and the constructors) and the frees of ClearMatrix. Recording
+// is compiled in only with -DS21_PROFILE (make test_profile); otherwise
+// the hooks expand to nothing and every count stays zero, though the
+// functions here still link. A method's time includes the methods it
+// calls, and those count on their own: MulMatrix shows up under Product
+// as well. Accessors and views are left out.
+
+#define S21_PROFILED_METHODS(X)                                           \
+  X(InitMatrix) X(ClearMatrix) X(CopyMatrix) X(FillMatrix) X(SetRows)     \
+  X(SetCols) X(EqMatrix) X(SumMatrix) X(SubMatrix) X(MulNumber)           \
+  X(MulMatrix) X(Product) X(Evaluate) X(Determinant) X(Transpose)         \
+  X(TransposeInPlace) X(CalcComplements) X(InverseMatrix) X(FactorLU)     \
+  X(FactorBareiss) X(SolveLU) X(FactorCholesky) X(SolveCholesky) X(Mul)   \
+  X(MulTransposed) X(Save) X(OpenMapped) X(ProductOutOfCore)
+
+#define S21_PROFILE_ENUM(name) kS21Profile##name,
+enum S21ProfiledMethod {
+  S21_PROFILED_METHODS(S21_PROFILE_ENUM) kS21ProfiledMethods
+};
+#undef S21_PROFILE_ENUM
+
+struct S21ProfileCounts {
+  std::uint64_t calls;
+  std::uint64_t nanoseconds;
+};
+
+struct S21ProfileSnapshot {
+  std::array<S21ProfileCounts, kS21ProfiledMethods> methods;
+  std::uint64_t allocations;
+  std::uint64_t frees;
+  std::uint64_t bytes_allocated;
+  std::uint64_t bytes_freed;
+  // most bytes held at once since the last reset
+  std::uint64_t peak_bytes;
+};
+
+const char* S21ProfiledMethodName(S21ProfiledMethod method);
+
+//=================   SNAPSHOTS   ======================
+S21ProfileSnapshot S21GetProfile();
+// zeroes every count and drops the recorded trace
+void S21ResetProfile();
+// one JSON object: "methods" maps each method called at least once to its
+// "calls" and "ns", followed by the allocation counts
+void S21WriteProfileJson(const S21ProfileSnapshot& snapshot,
+                         std::ostream& out);
+
+//=================   TRACING   ======================
+// While on, each call is also kept as a complete ("ph": "X") event of the
+// Chrome trace format, for chrome://tracing or Perfetto. Events pile up
+// until S21ResetProfile, so keep tracing to the stretch of interest.
+void S21SetTracing(bool on);
+void S21WriteTrace(std::ostream& out);
+
+//=================   HOOKS   ======================
+
+// times its scope into the counts of one method
+class S21ProfileScope {
+ public:
+  explicit S21ProfileScope(S21ProfiledMethod method);
+  ~S21ProfileScope();
+  S21ProfileScope(const S21ProfileScope&) = delete;
+  S21ProfileScope& operator=(const S21ProfileScope&) = delete;
+
+ private:
+  S21ProfiledMethod method_;
+  std::int64_t start_;
+};
+
+void S21ProfileAllocation(std::size_t bytes);
+void S21ProfileFree(std::size_t bytes);
+
+#ifdef S21_PROFILE
+#define S21_PROFILE_SCOPE(name) \
+  const S21ProfileScope s21ProfileScope(kS21Profile##name)
+#define S21_PROFILE_ALLOCATION(bytes) S21ProfileAllocation(bytes)
+#define S21_PROFILE_FREE(bytes) S21ProfileFree(bytes)
+#else
+#define S21_PROFILE_SCOPE(name) static_cast<void>(0)
+#define S21_PROFILE_ALLOCATION(bytes) static_cast<void>(0)
+#define S21_PROFILE_FREE(bytes) static_cast<void>(0)
+#endif
+
+#endif  // S21_PROFILE_H
@@ -0,0 +1,211 @@
+#include "s21_qr.h"
+
+#include "s21_gemm.h"
+#include "s21_simd.h"
+
+#define TMPL template <typename T>
+#define QR S21BasicQR<T>
+// columns per panel
+#define QR_BLOCK 32
+// rows of reflectors transposed at a time for V^T * C
+#define QR_CHUNK 4096
+
+//=================  CONSTRUCTORS   ======================
+
+TMPL QR::S21BasicQR(const S21BasicMatrix<T> &matrix)
+    : qr_(matrix), t_(QR_BLOCK, matrix.GetCols()) {
+  const int n = GetCols();
+  if (GetRows() < n) throw std::invalid_argument("Fewer rows than columns");
+  T taus[QR_BLOCK];
+  for (int k0 = 0; k0 < n; k0 += QR_BLOCK) {
+    const int end = std::min(k0 + QR_BLOCK, n);
+    FactorPanel(k0, end, taus);
+    FormT(k0, end, taus);
+    if (end < n)
+      ApplyPanel(k0, end, true, qr_.matrix_ + end, qr_.stride_, n - end);
+  }
+}
+
+//=================   GET   ======================
+
+TMPL S21BasicMatrix<T> QR::GetR() const {
+  const int n = GetCols();
+  S21BasicMatrix<T> r(n, n);
+  FOR(n) std::copy(qr_.RowPtr(i) + i, qr_.RowPtr(i) + n, r.RowPtr(i) + i);
+  return r;
+}
+
+// Q * [I; 0], the last panel first: a panel leaves the columns before it
+// alone while they are still columns of the identity
+TMPL S21BasicMatrix<T> QR::GetThinQ() const {
+  const int n = GetCols();
+  S21BasicMatrix<T> q(GetRows(), n);
+  FOR(n) q.RowPtr(i)[i] = 1;
+  for (int k0 = (n - 1) / QR_BLOCK * QR_BLOCK; k0 >= 0; k0 -= QR_BLOCK)
+    ApplyPanel(k0, std::min(k0 + QR_BLOCK, n), false, q.matrix_ + k0,
+               q.stride_, n - k0);
+  return q;
+}
+
+//=================   OPERATIONS   ======================
+
+TMPL S21BasicVector<T> QR::LeastSquares(const S21BasicVector<T> &b) const {
+  if (b.GetSize() != GetRows()) throw std::invalid_argument("Invalid sizes");
+  S21BasicVector<T> c = b;
+  for (int k0 = 0; k0 < GetCols(); k0 += QR_BLOCK)
+    ApplyPanel(k0, std::min(k0 + QR_BLOCK, GetCols()), true, c.Data(), 1, 1);
+  SolveR(c.Data(), 1, 1);
+  return S21BasicVector<T>(c.AsRow().Block(0, 0, 1, GetCols()));
+}
+
+TMPL S21BasicMatrix<T> QR::LeastSquares(const S21BasicMatrix<T> &b) const {
+  if (b.GetRows() != GetRows()) throw std::invalid_argument("Invalid sizes");
+  S21BasicMatrix<T> c = b;
+  for (int k0 = 0; k0 < GetCols(); k0 += QR_BLOCK)
+    ApplyPanel(k0, std::min(k0 + QR_BLOCK, GetCols()), true, c.matrix_,
+               c.stride_, c.cols_);
+  SolveR(c.matrix_, c.stride_, c.cols_);
+  return S21BasicMatrix<T>(c.Block(0, 0, GetCols(), c.cols_));
+}
+
+//=================   SUPPLEMENTARY   ======================
+
+// Householder reflectors of columns k0 .. end, applied within the panel.
+// One pass over the rows per column: the pass that applies reflector j
+// also sums, over the rows below j + 1, |column j + 1|^2 and column j + 1
+// times the columns after it, which is all reflector j + 1 needs.
+TMPL void QR::FactorPanel(int k0, int end, T *taus) {
+  const int m = GetRows(), nb = end - k0;
+  // sums[c - k0] = sum over i > j of A(i, j) * A(i, c) for c >= j
+  T sums[QR_BLOCK] = {}, next[QR_BLOCK], w[QR_BLOCK];
+  for (int i = k0 + 1; i < m; ++i) {
+    const T *row = qr_.RowPtr(i);
+    for (int c = k0; c < end; ++c) sums[c - k0] += row[k0] * row[c];
+  }
+  for (int j = k0; j < end; ++j) {
+    T *top = qr_.RowPtr(j);
+    const T alpha = top[j], sigma = sums[j - k0];
+    T tau = 0, scale = 0;
+    if (sigma != 0) {
+      const T beta = -std::copysign(std::sqrt(alpha * alpha + sigma), alpha);
+      tau = (beta - alpha) / beta, scale = 1 / (alpha - beta), top[j] = beta;
+      // w = tau * v^T * A(:, c), v being column j scaled, with v(j) = 1
+      for (int c = j + 1; c < end; ++c)
+        top[c] -= w[c - k0] = tau * (top[c] + scale * sums[c - k0]);
+    }
+    taus[j - k0] = tau;
+    std::fill_n(next, nb, T());
+    for (int i = j + 1; i < m; ++i) {
+      T *row = qr_.RowPtr(i);
+      if (tau != 0) {
+        const T v = row[j] *= scale;
+        for (int c = j + 1; c < end; ++c) row[c] -= v * w[c - k0];
+      }
+      if (i > j + 1 && j + 1 < end)
+        for (int c = j + 1; c < end; ++c)
+          next[c - k0] += row[j + 1] * row[c];
+    }
+    std::copy_n(next, nb, sums);
+  }
+}
+
+// T of the panel from the Gram matrix of its reflectors: column j of T is
+// -tau_j * T(0 .. j, 0 .. j) * V(:, 0 .. j)^T * v_j
+TMPL void QR::FormT(int k0, int end, const T *taus) {
+  const int m = GetRows(), nb = end - k0;
+  S21BasicMatrix<T> gram(nb, nb);
+  for (int r = k0; r < end; ++r)
+    for (int p = 0; p <= r - k0; ++p)
+      for (int q = 0; q <= r - k0; ++q)
+        gram.RowPtr(p)[q] += V(r, k0 + p) * V(r, k0 + q);
+  if (end < m) {
+    const S21Kernels<T> &kernels = S21GetKernels<T>();
+    S21BasicMatrix<T> vt(nb, std::min(QR_CHUNK, m - end));
+    for (int r0 = end; r0 < m; r0 += QR_CHUNK) {
+      const int rows = std::min(QR_CHUNK, m - r0);
+      kernels.transpose(rows, nb, qr_.RowPtr(r0) + k0, qr_.stride_,
+                        vt.matrix_, vt.stride_);
+      S21Gemm(nb, nb, rows, vt.matrix_, vt.stride_, qr_.RowPtr(r0) + k0,
+              qr_.stride_, gram.matrix_, gram.stride_);
+    }
+  }
+  for (int j = 0; j < nb; ++j) {
+    t_.RowPtr(j)[k0 + j] = taus[j];
+    for (int p = 0; p < j; ++p) {
+      T sum = 0;
+      for (int q = p; q < j; ++q)
+        sum += t_.RowPtr(p)[k0 + q] * gram.RowPtr(q)[j];
+      t_.RowPtr(p)[k0 + j] = -taus[j] * sum;
+    }
+  }
+}
+
+// C = (I - V * op(T) * V^T) * C on rows k0 .. of the m x nc block at c,
+// op(T) being T^T for Q^T and T for Q. V splits into its unit lower
+// triangular top V1 and the rectangle V2 below it, which Gemm reads in
+// place: W = V1^T * C1 + V2^T * C2, then C1 -= V1 * op(T) W and
+// C2 -= V2 * op(T) W.
+TMPL void QR::ApplyPanel(int k0, int end, bool transpose, T *c, int ldc,
+                         int nc) const {
+  const S21Kernels<T> &kernels = S21GetKernels<T>();
+  const int m = GetRows(), nb = end - k0;
+  auto at = [&](int row) { return c + std::ptrdiff_t(row) * ldc; };
+  S21BasicMatrix<T> w(nb, nc);
+  for (int r = k0; r < end; ++r)
+    for (int p = 0; p <= r - k0; ++p)
+      kernels.axpy(nc, w.RowPtr(p), at(r), V(r, k0 + p));
+  if (end < m) {
+    S21BasicMatrix<T> vt(nb, std::min(QR_CHUNK, m - end));
+    for (int r0 = end; r0 < m; r0 += QR_CHUNK) {
+      const int rows = std::min(QR_CHUNK, m - r0);
+      kernels.transpose(rows, nb, qr_.RowPtr(r0) + k0, qr_.stride_,
+                        vt.matrix_, vt.stride_);
+      S21Gemm(nb, nc, rows, vt.matrix_, vt.stride_, at(r0), ldc, w.matrix_,
+              w.stride_);
+    }
+  }
+  // W = -op(T) * W in place, T upper triangular
+  auto t = [&](int i, int j) { return t_.RowPtr(i)[k0 + j]; };
+  for (int s = 0; s < nb; ++s) {
+    const int i = transpose ? nb - 1 - s : s;
+    kernels.scale(nc, w.RowPtr(i), -t(i, i));
+    if (transpose)
+      for (int p = 0; p < i; ++p)
+        kernels.axpy(nc, w.RowPtr(i), w.RowPtr(p), -t(p, i));
+    else
+      for (int p = i + 1; p < nb; ++p)
+        kernels.axpy(nc, w.RowPtr(i), w.RowPtr(p), -t(i, p));
+  }
+  if (end < m)
+    S21Gemm(m - end, nc, nb, qr_.RowPtr(end) + k0, qr_.stride_, w.matrix_,
+            w.stride_, at(end), ldc);
+  for (int r = k0; r < end; ++r)
+    for (int p = 0; p <= r - k0; ++p)
+      kernels.axpy(nc, at(r), w.RowPtr(p), V(r, k0 + p));
+}
+
+// R * X = C(0 .. n) by back substitution in place; throws when a diagonal
+// entry of R is negligible next to the largest, by the S21NegligiblePivot
+// bound LU uses, so badly scaled but independent columns still solve
+TMPL void QR::SolveR(T *c, int ldc, int nc) const {
+  const S21Kernels<T> &kernels = S21GetKernels<T>();
+  const int n = GetCols();
+  T largest = 0;
+  FOR(n) largest = std::max(largest, std::abs(qr_.RowPtr(i)[i]));
+  for (int i = 0; i < n; ++i)
+    if (S21NegligiblePivot(qr_.RowPtr(i)[i], n, largest))
+      throw std::logic_error("Matrix is rank deficient");
+  for (int i = n - 1; i >= 0; --i) {
+    const T *r = qr_.RowPtr(i);
+    T *x = c + std::ptrdiff_t(i) * ldc;
+    if (ldc == 1)  // a vector
+      x[0] -= kernels.dot(n - i - 1, r + i + 1, x + 1);
+    else
+      for (int k = i + 1; k < n; ++k)
+        kernels.axpy(nc, x, c + std::ptrdiff_t(k) * ldc, -r[k]);
+    kernels.scale(nc, x, 1 / r[i]);
+  }
+}
+
+#define INSTANTIATE(T) template class S21BasicQR<T>;
+S21_REAL_TYPES(INSTANTIATE)
@@ -0,0 +1,57 @@
+#ifndef S21_QR_H
+#define S21_QR_H
+
+#include "s21_matrix_oop.h"
+
+//=================   QR FACTORIZATION   ======================
+// A = Q * R for m x n A with m >= n, by Householder reflectors in compact
+// WY form: each QR_BLOCK-column panel's reflectors combine into
+// I - V * T * V^T, applied to the rest of A, to right-hand sides or to Q
+// with two Gemm passes over the rows. Least squares goes through R alone,
+// so the condition number is never squared as with A^T * A. Only for the
+// types in S21_REAL_TYPES.
+
+template <typename T>
+class S21BasicQR {
+  static_assert(std::is_floating_point_v<T>, "Real reflectors only");
+
+ public:
+  using Scalar = T;
+
+  //=================  CONSTRUCTORS   ======================
+  explicit S21BasicQR(const S21BasicMatrix<T>& matrix);
+
+  //=================   GET   ======================
+  int GetRows() const { return qr_.GetRows(); }
+  int GetCols() const { return qr_.GetCols(); }
+  // n x n upper triangular
+  S21BasicMatrix<T> GetR() const;
+  // the first n columns of Q, m x n with orthonormal columns
+  S21BasicMatrix<T> GetThinQ() const;
+
+  //=================   OPERATIONS   ======================
+  // x minimizing |A * x - b|, for one or many right-hand sides; throws when
+  // A is rank deficient
+  S21BasicVector<T> LeastSquares(const S21BasicVector<T>& b) const;
+  S21BasicMatrix<T> LeastSquares(const S21BasicMatrix<T>& b) const;
+
+ private:
+  // element (row, col) of the reflectors, their unit diagonal included
+  T V(int row, int col) const {
+    return row == col ? T(1) : row > col ? qr_.RowPtr(row)[col] : T(0);
+  }
+  void FactorPanel(int k0, int end, T* taus);
+  void FormT(int k0, int end, const T* taus);
+  void ApplyPanel(int k0, int end, bool transpose, T* c, int ldc,
+                  int nc) const;
+  void SolveR(T* c, int ldc, int nc) const;
+
+  // R on and above the diagonal, the reflectors below it
+  S21BasicMatrix<T> qr_;
+  // the T of the panel starting at column k0 in columns k0 .. k0 + QR_BLOCK
+  S21BasicMatrix<T> t_;
+};
+
+using S21QR = S21BasicQR<double>;
+
+#endif  // S21_QR_H
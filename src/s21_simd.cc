@@ -0,0 +1,380 @@
+#include "s21_simd.h"
+
+#include <cmath>
+#include <initializer_list>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define S21_X86 1
+#include <immintrin.h>
+#endif
+
+//=================   SCALAR   ======================
+
+template <typename T>
+static void AddScalar(int n, T* dst, const T* src) {
+  for (int i = 0; i < n; ++i) dst[i] += src[i];
+}
+
+template <typename T>
+static void SubScalar(int n, T* dst, const T* src) {
+  for (int i = 0; i < n; ++i) dst[i] -= src[i];
+}
+
+template <typename T>
+static void ScaleScalar(int n, T* dst, T num) {
+  for (int i = 0; i < n; ++i) dst[i] *= num;
+}
+
+template <typename T>
+static bool EqualScalar(int n, const T* a, const T* b,
+                        typename S21Traits<T>::Real eps) {
+  for (int i = 0; i < n; ++i)
+    if (S21Abs(a[i] - b[i]) >= eps) return false;
+  return true;
+}
+
+template <typename T>
+static void TransposeScalar(int rows, int cols, const T* src, int lds,
+                            T* dst, int ldd) {
+  for (int i = 0; i < rows; ++i)
+    for (int j = 0; j < cols; ++j) dst[j * ldd + i] = src[i * lds + j];
+}
+
+template <typename T>
+static T DotScalar(int n, const T* a, const T* b) {
+  T sum = T();
+  for (int i = 0; i < n; ++i) sum += a[i] * b[i];
+  return sum;
+}
+
+template <typename T>
+static void AxpyScalar(int n, T* dst, const T* src, T alpha) {
+  for (int i = 0; i < n; ++i) dst[i] += alpha * src[i];
+}
+
+template <typename T>
+static const S21Kernels<T> kScalar = {
+    kS21Scalar,        "scalar",     AddScalar<T>,   SubScalar<T>,
+    ScaleScalar<T>,    EqualScalar<T>, TransposeScalar<T>, DotScalar<T>,
+    AxpyScalar<T>};
+
+// element types without vector tables
+template <typename T>
+static const S21Kernels<T>* Vector(S21Isa, const T*) {
+  return nullptr;
+}
+
+#ifdef S21_X86
+
+//=================   VECTOR   ======================
+// W lanes per register; the tail that does not fill one goes scalar.
+
+#define SIMD_BINARY(NAME, T, OP, TARGET, W, LOAD, STORE, VOP)                \
+  __attribute__((target(TARGET))) static void NAME(int n, T* dst,            \
+                                                   const T* src) {           \
+    int i = 0;                                                              \
+    for (; i + W <= n; i += W)                                              \
+      STORE(dst + i, VOP(LOAD(dst + i), LOAD(src + i)));                    \
+    for (; i < n; ++i) dst[i] OP src[i];                                    \
+  }
+
+#define SIMD_SCALE(NAME, T, TARGET, W, LOAD, STORE, MUL, SET1)               \
+  __attribute__((target(TARGET))) static void NAME(int n, T* dst, T num) {  \
+    const auto factor = SET1(num);                                          \
+    int i = 0;                                                              \
+    for (; i + W <= n; i += W)                                              \
+      STORE(dst + i, MUL(LOAD(dst + i), factor));                           \
+    for (; i < n; ++i) dst[i] *= num;                                       \
+  }
+
+// FAR(diff, tol) is nonzero when some lane is at least tol away from zero
+#define SIMD_EQUAL(NAME, T, TARGET, W, LOAD, SUB, SET1, FAR)                 \
+  __attribute__((target(TARGET))) static bool NAME(int n, const T* a,       \
+                                                   const T* b, T eps) {     \
+    const auto tol = SET1(eps);                                             \
+    int i = 0;                                                              \
+    for (; i + W <= n; i += W)                                              \
+      if (FAR(SUB(LOAD(a + i), LOAD(b + i)), tol)) return false;            \
+    return EqualScalar(n - i, a + i, b + i, eps);                           \
+  }
+
+// |diff| is taken by clearing the sign bit; the ordered >= keeps NaN
+// differences "equal" exactly like the scalar abs(...) >= eps test.
+
+__attribute__((target("sse2"))) static inline int FarSse2(__m128d diff,
+                                                         __m128d tol) {
+  return _mm_movemask_pd(
+      _mm_cmpge_pd(_mm_andnot_pd(_mm_set1_pd(-0.0), diff), tol));
+}
+
+__attribute__((target("sse2"))) static inline int FarSse2(__m128 diff,
+                                                         __m128 tol) {
+  return _mm_movemask_ps(
+      _mm_cmpge_ps(_mm_andnot_ps(_mm_set1_ps(-0.0f), diff), tol));
+}
+
+__attribute__((target("avx2"))) static inline int FarAvx2(__m256d diff,
+                                                         __m256d tol) {
+  return _mm256_movemask_pd(_mm256_cmp_pd(
+      _mm256_andnot_pd(_mm256_set1_pd(-0.0), diff), tol, _CMP_GE_OQ));
+}
+
+__attribute__((target("avx2"))) static inline int FarAvx2(__m256 diff,
+                                                         __m256 tol) {
+  return _mm256_movemask_ps(_mm256_cmp_ps(
+      _mm256_andnot_ps(_mm256_set1_ps(-0.0f), diff), tol, _CMP_GE_OQ));
+}
+
+__attribute__((target("avx512f"))) static inline int FarAvx512(__m512d diff,
+                                                              __m512d tol) {
+  return _mm512_cmp_pd_mask(_mm512_abs_pd(diff), tol, _CMP_GE_OQ);
+}
+
+__attribute__((target("avx512f"))) static inline int FarAvx512(__m512 diff,
+                                                              __m512 tol) {
+  return _mm512_cmp_ps_mask(_mm512_abs_ps(diff), tol, _CMP_GE_OQ);
+}
+
+// four independent accumulators hide the latency of the adds
+#define SIMD_DOT(NAME, T, TARGET, W, LOAD, STORE, ADD, MUL, ZERO)           \
+  __attribute__((target(TARGET))) static T NAME(int n, const T* a,          \
+                                                const T* b) {               \
+    auto s0 = ZERO(), s1 = ZERO(), s2 = ZERO(), s3 = ZERO();                \
+    int i = 0;                                                              \
+    for (; i + 4 * W <= n; i += 4 * W) {                                    \
+      s0 = ADD(s0, MUL(LOAD(a + i), LOAD(b + i)));                          \
+      s1 = ADD(s1, MUL(LOAD(a + i + W), LOAD(b + i + W)));                  \
+      s2 = ADD(s2, MUL(LOAD(a + i + 2 * W), LOAD(b + i + 2 * W)));          \
+      s3 = ADD(s3, MUL(LOAD(a + i + 3 * W), LOAD(b + i + 3 * W)));          \
+    }                                                                       \
+    for (; i + W <= n; i += W) s0 = ADD(s0, MUL(LOAD(a + i), LOAD(b + i))); \
+    T lanes[W];                                                             \
+    STORE(lanes, ADD(ADD(s0, s1), ADD(s2, s3)));                            \
+    T sum = DotScalar(n - i, a + i, b + i);                                 \
+    for (int l = 0; l < W; ++l) sum += lanes[l];                            \
+    return sum;                                                             \
+  }
+
+#define SIMD_AXPY(NAME, T, TARGET, W, LOAD, STORE, ADD, MUL, SET1)           \
+  __attribute__((target(TARGET))) static void NAME(int n, T* dst,           \
+                                                   const T* src, T alpha) { \
+    const auto factor = SET1(alpha);                                        \
+    int i = 0;                                                              \
+    for (; i + W <= n; i += W)                                              \
+      STORE(dst + i, ADD(LOAD(dst + i), MUL(LOAD(src + i), factor)));       \
+    AxpyScalar(n - i, dst + i, src + i, alpha);                             \
+  }
+
+// square W x W register tiles over the bulk, scalar along the ragged edges
+#define SIMD_TRANSPOSE(NAME, T, TARGET, W, TILE)                            \
+  __attribute__((target(TARGET))) static void NAME(                        \
+      int rows, int cols, const T* src, int lds, T* dst, int ldd) {        \
+    int i = 0;                                                              \
+    for (; i + W <= rows; i += W) {                                         \
+      int j = 0;                                                            \
+      for (; j + W <= cols; j += W)                                         \
+        TILE(src + i * lds + j, lds, dst + j * ldd + i, ldd);               \
+      TransposeScalar(W, cols - j, src + i * lds + j, lds,                  \
+                      dst + j * ldd + i, ldd);                              \
+    }                                                                       \
+    TransposeScalar(rows - i, cols, src + i * lds, lds, dst + i, ldd);      \
+  }
+
+//=================   DOUBLE   ======================
+
+SIMD_BINARY(AddSse2, double, +=, "sse2", 2, _mm_loadu_pd, _mm_storeu_pd,
+            _mm_add_pd)
+SIMD_BINARY(SubSse2, double, -=, "sse2", 2, _mm_loadu_pd, _mm_storeu_pd,
+            _mm_sub_pd)
+SIMD_SCALE(ScaleSse2, double, "sse2", 2, _mm_loadu_pd, _mm_storeu_pd,
+           _mm_mul_pd, _mm_set1_pd)
+SIMD_EQUAL(EqualSse2, double, "sse2", 2, _mm_loadu_pd, _mm_sub_pd,
+           _mm_set1_pd, FarSse2)
+
+SIMD_BINARY(AddAvx2, double, +=, "avx2", 4, _mm256_loadu_pd, _mm256_storeu_pd,
+            _mm256_add_pd)
+SIMD_BINARY(SubAvx2, double, -=, "avx2", 4, _mm256_loadu_pd, _mm256_storeu_pd,
+            _mm256_sub_pd)
+SIMD_SCALE(ScaleAvx2, double, "avx2", 4, _mm256_loadu_pd, _mm256_storeu_pd,
+           _mm256_mul_pd, _mm256_set1_pd)
+SIMD_EQUAL(EqualAvx2, double, "avx2", 4, _mm256_loadu_pd, _mm256_sub_pd,
+           _mm256_set1_pd, FarAvx2)
+
+SIMD_BINARY(AddAvx512, double, +=, "avx512f", 8, _mm512_loadu_pd,
+            _mm512_storeu_pd, _mm512_add_pd)
+SIMD_BINARY(SubAvx512, double, -=, "avx512f", 8, _mm512_loadu_pd,
+            _mm512_storeu_pd, _mm512_sub_pd)
+SIMD_SCALE(ScaleAvx512, double, "avx512f", 8, _mm512_loadu_pd,
+           _mm512_storeu_pd, _mm512_mul_pd, _mm512_set1_pd)
+SIMD_EQUAL(EqualAvx512, double, "avx512f", 8, _mm512_loadu_pd, _mm512_sub_pd,
+           _mm512_set1_pd, FarAvx512)
+
+SIMD_DOT(DotSse2, double, "sse2", 2, _mm_loadu_pd, _mm_storeu_pd, _mm_add_pd,
+         _mm_mul_pd, _mm_setzero_pd)
+SIMD_AXPY(AxpySse2, double, "sse2", 2, _mm_loadu_pd, _mm_storeu_pd,
+          _mm_add_pd, _mm_mul_pd, _mm_set1_pd)
+SIMD_DOT(DotAvx2, double, "avx2", 4, _mm256_loadu_pd, _mm256_storeu_pd,
+         _mm256_add_pd, _mm256_mul_pd, _mm256_setzero_pd)
+SIMD_AXPY(AxpyAvx2, double, "avx2", 4, _mm256_loadu_pd, _mm256_storeu_pd,
+          _mm256_add_pd, _mm256_mul_pd, _mm256_set1_pd)
+SIMD_DOT(DotAvx512, double, "avx512f", 8, _mm512_loadu_pd, _mm512_storeu_pd,
+         _mm512_add_pd, _mm512_mul_pd, _mm512_setzero_pd)
+SIMD_AXPY(AxpyAvx512, double, "avx512f", 8, _mm512_loadu_pd, _mm512_storeu_pd,
+          _mm512_add_pd, _mm512_mul_pd, _mm512_set1_pd)
+
+__attribute__((target("sse2"))) static inline void Tile2(const double* src,
+                                                        int lds, double* dst,
+                                                        int ldd) {
+  const __m128d r0 = _mm_loadu_pd(src), r1 = _mm_loadu_pd(src + lds);
+  _mm_storeu_pd(dst, _mm_unpacklo_pd(r0, r1));
+  _mm_storeu_pd(dst + ldd, _mm_unpackhi_pd(r0, r1));
+}
+
+__attribute__((target("avx2"))) static inline void Tile4(const double* src,
+                                                        int lds, double* dst,
+                                                        int ldd) {
+  const __m256d r0 = _mm256_loadu_pd(src), r1 = _mm256_loadu_pd(src + lds),
+                r2 = _mm256_loadu_pd(src + 2 * lds),
+                r3 = _mm256_loadu_pd(src + 3 * lds);
+  const __m256d t0 = _mm256_unpacklo_pd(r0, r1),
+                t1 = _mm256_unpackhi_pd(r0, r1),
+                t2 = _mm256_unpacklo_pd(r2, r3),
+                t3 = _mm256_unpackhi_pd(r2, r3);
+  _mm256_storeu_pd(dst, _mm256_permute2f128_pd(t0, t2, 0x20));
+  _mm256_storeu_pd(dst + ldd, _mm256_permute2f128_pd(t1, t3, 0x20));
+  _mm256_storeu_pd(dst + 2 * ldd, _mm256_permute2f128_pd(t0, t2, 0x31));
+  _mm256_storeu_pd(dst + 3 * ldd, _mm256_permute2f128_pd(t1, t3, 0x31));
+}
+
+SIMD_TRANSPOSE(TransposeSse2, double, "sse2", 2, Tile2)
+SIMD_TRANSPOSE(TransposeAvx2, double, "avx2", 4, Tile4)
+
+static const S21Kernels<double> kSse2 = {
+    kS21Sse2,      "sse2",  AddSse2,  SubSse2, ScaleSse2, EqualSse2,
+    TransposeSse2, DotSse2, AxpySse2};
+static const S21Kernels<double> kAvx2 = {
+    kS21Avx2,      "avx2",  AddAvx2,  SubAvx2, ScaleAvx2, EqualAvx2,
+    TransposeAvx2, DotAvx2, AxpyAvx2};
+// AVX-512F implies AVX2, so its 4 x 4 transpose tile is reused
+static const S21Kernels<double> kAvx512 = {
+    kS21Avx512,    "avx512",  AddAvx512,  SubAvx512, ScaleAvx512, EqualAvx512,
+    TransposeAvx2, DotAvx512, AxpyAvx512};
+
+static const S21Kernels<double>* Vector(S21Isa isa, const double*) {
+  static const S21Kernels<double>* const tables[] = {nullptr, &kSse2, &kAvx2,
+                                                     &kAvx512};
+  return tables[isa];
+}
+
+//=================   FLOAT   ======================
+// twice the lanes of double in the same registers
+
+SIMD_BINARY(AddSse2F, float, +=, "sse2", 4, _mm_loadu_ps, _mm_storeu_ps,
+            _mm_add_ps)
+SIMD_BINARY(SubSse2F, float, -=, "sse2", 4, _mm_loadu_ps, _mm_storeu_ps,
+            _mm_sub_ps)
+SIMD_SCALE(ScaleSse2F, float, "sse2", 4, _mm_loadu_ps, _mm_storeu_ps,
+           _mm_mul_ps, _mm_set1_ps)
+SIMD_EQUAL(EqualSse2F, float, "sse2", 4, _mm_loadu_ps, _mm_sub_ps,
+           _mm_set1_ps, FarSse2)
+
+SIMD_BINARY(AddAvx2F, float, +=, "avx2", 8, _mm256_loadu_ps, _mm256_storeu_ps,
+            _mm256_add_ps)
+SIMD_BINARY(SubAvx2F, float, -=, "avx2", 8, _mm256_loadu_ps, _mm256_storeu_ps,
+            _mm256_sub_ps)
+SIMD_SCALE(ScaleAvx2F, float, "avx2", 8, _mm256_loadu_ps, _mm256_storeu_ps,
+           _mm256_mul_ps, _mm256_set1_ps)
+SIMD_EQUAL(EqualAvx2F, float, "avx2", 8, _mm256_loadu_ps, _mm256_sub_ps,
+           _mm256_set1_ps, FarAvx2)
+
+SIMD_BINARY(AddAvx512F, float, +=, "avx512f", 16, _mm512_loadu_ps,
+            _mm512_storeu_ps, _mm512_add_ps)
+SIMD_BINARY(SubAvx512F, float, -=, "avx512f", 16, _mm512_loadu_ps,
+            _mm512_storeu_ps, _mm512_sub_ps)
+SIMD_SCALE(ScaleAvx512F, float, "avx512f", 16, _mm512_loadu_ps,
+           _mm512_storeu_ps, _mm512_mul_ps, _mm512_set1_ps)
+SIMD_EQUAL(EqualAvx512F, float, "avx512f", 16, _mm512_loadu_ps, _mm512_sub_ps,
+           _mm512_set1_ps, FarAvx512)
+
+__attribute__((target("sse2"))) static inline void Tile4F(const float* src,
+                                                         int lds, float* dst,
+                                                         int ldd) {
+  __m128 r0 = _mm_loadu_ps(src), r1 = _mm_loadu_ps(src + lds),
+         r2 = _mm_loadu_ps(src + 2 * lds), r3 = _mm_loadu_ps(src + 3 * lds);
+  _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+  _mm_storeu_ps(dst, r0);
+  _mm_storeu_ps(dst + ldd, r1);
+  _mm_storeu_ps(dst + 2 * ldd, r2);
+  _mm_storeu_ps(dst + 3 * ldd, r3);
+}
+
+SIMD_TRANSPOSE(TransposeSse2F, float, "sse2", 4, Tile4F)
+
+SIMD_DOT(DotSse2F, float, "sse2", 4, _mm_loadu_ps, _mm_storeu_ps, _mm_add_ps,
+         _mm_mul_ps, _mm_setzero_ps)
+SIMD_AXPY(AxpySse2F, float, "sse2", 4, _mm_loadu_ps, _mm_storeu_ps,
+          _mm_add_ps, _mm_mul_ps, _mm_set1_ps)
+SIMD_DOT(DotAvx2F, float, "avx2", 8, _mm256_loadu_ps, _mm256_storeu_ps,
+         _mm256_add_ps, _mm256_mul_ps, _mm256_setzero_ps)
+SIMD_AXPY(AxpyAvx2F, float, "avx2", 8, _mm256_loadu_ps, _mm256_storeu_ps,
+          _mm256_add_ps, _mm256_mul_ps, _mm256_set1_ps)
+SIMD_DOT(DotAvx512F, float, "avx512f", 16, _mm512_loadu_ps, _mm512_storeu_ps,
+         _mm512_add_ps, _mm512_mul_ps, _mm512_setzero_ps)
+SIMD_AXPY(AxpyAvx512F, float, "avx512f", 16, _mm512_loadu_ps,
+          _mm512_storeu_ps, _mm512_add_ps, _mm512_mul_ps, _mm512_set1_ps)
+
+// the wider sets reuse the 4 x 4 transpose tile
+static const S21Kernels<float> kSse2F = {
+    kS21Sse2,       "sse2",   AddSse2F,  SubSse2F, ScaleSse2F, EqualSse2F,
+    TransposeSse2F, DotSse2F, AxpySse2F};
+static const S21Kernels<float> kAvx2F = {
+    kS21Avx2,       "avx2",   AddAvx2F,  SubAvx2F, ScaleAvx2F, EqualAvx2F,
+    TransposeSse2F, DotAvx2F, AxpyAvx2F};
+static const S21Kernels<float> kAvx512F = {
+    kS21Avx512,     "avx512",   AddAvx512F,  SubAvx512F, ScaleAvx512F,
+    EqualAvx512F,   TransposeSse2F, DotAvx512F, AxpyAvx512F};
+
+static const S21Kernels<float>* Vector(S21Isa isa, const float*) {
+  static const S21Kernels<float>* const tables[] = {nullptr, &kSse2F, &kAvx2F,
+                                                    &kAvx512F};
+  return tables[isa];
+}
+
+#endif  // S21_X86
+
+//=================   DISPATCH   ======================
+
+static bool Supported(S21Isa isa) {
+#ifdef S21_X86
+  __builtin_cpu_init();
+  if (isa == kS21Avx512) return __builtin_cpu_supports("avx512f");
+  if (isa == kS21Avx2) return __builtin_cpu_supports("avx2");
+  if (isa == kS21Sse2) return __builtin_cpu_supports("sse2");
+#endif
+  return isa == kS21Scalar;
+}
+
+template <typename T>
+const S21Kernels<T>* S21KernelsFor(S21Isa isa) {
+  if (isa == kS21Scalar) return &kScalar<T>;
+  return Supported(isa) ? Vector(isa, static_cast<const T*>(nullptr))
+                        : nullptr;
+}
+
+template <typename T>
+static const S21Kernels<T>& SelectKernels() {
+  for (S21Isa isa : {kS21Avx512, kS21Avx2, kS21Sse2})
+    if (const S21Kernels<T>* kernels = S21KernelsFor<T>(isa)) return *kernels;
+  return kScalar<T>;
+}
+
+template <typename T>
+const S21Kernels<T>& S21GetKernels() {
+  static const S21Kernels<T>& kernels = SelectKernels<T>();
+  return kernels;
+}
+
+#define INSTANTIATE(T)                                 \
+  template const S21Kernels<T>& S21GetKernels<T>(); \
+  template const S21Kernels<T>* S21KernelsFor<T>(S21Isa isa);
+S21_ELEMENT_TYPES(INSTANTIATE)
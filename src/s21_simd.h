@@ -0,0 +1,39 @@
+#ifndef S21_SIMD_H
+#define S21_SIMD_H
+
+#include "s21_traits.h"
+
+//=================   ELEMENT-WISE KERNELS   ======================
+// One table per instruction set and element type; S21GetKernels() picks
+// the widest one the CPU supports the first time it is called and keeps it
+// for the process. float and double have vector tables, the other element
+// types run the scalar one.
+
+enum S21Isa { kS21Scalar, kS21Sse2, kS21Avx2, kS21Avx512 };
+
+template <typename T>
+struct S21Kernels {
+  using Real = typename S21Traits<T>::Real;
+  S21Isa isa;
+  const char* name;
+  void (*add)(int n, T* dst, const T* src);
+  void (*sub)(int n, T* dst, const T* src);
+  void (*scale)(int n, T* dst, T num);
+  // false as soon as some |a[i] - b[i]| >= eps
+  bool (*equal)(int n, const T* a, const T* b, Real eps);
+  // dst(j, i) = src(i, j) for a rows x cols tile of src
+  void (*transpose)(int rows, int cols, const T* src, int lds, T* dst,
+                    int ldd);
+  // sum of a[i] * b[i], without conjugation
+  T (*dot)(int n, const T* a, const T* b);
+  // dst[i] += alpha * src[i]
+  void (*axpy)(int n, T* dst, const T* src, T alpha);
+};
+
+template <typename T = double>
+const S21Kernels<T>& S21GetKernels();
+// nullptr when this build, this CPU or this element type cannot run the set
+template <typename T = double>
+const S21Kernels<T>* S21KernelsFor(S21Isa isa);
+
+#endif  // S21_SIMD_H
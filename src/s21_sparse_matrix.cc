@@ -0,0 +1,288 @@
+#include "s21_sparse_matrix.h"
+
+#include <numeric>
+
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+
+#define TMPL template <typename T>
+#define SPARSE S21BasicSparseMatrix<T>
+
+// f(col, x, y) for every column stored in row i of a or of b, the side that
+// lacks it reading zero; stops at the first false
+template <typename T, typename F>
+static bool ZipRow(const SPARSE &a, const SPARSE &b, int i, const F &f) {
+  int p = a.GetRowPtr()[i], q = b.GetRowPtr()[i];
+  const int pEnd = a.GetRowPtr()[i + 1], qEnd = b.GetRowPtr()[i + 1];
+  while (p < pEnd || q < qEnd) {
+    const int u = p < pEnd ? a.GetColIndex()[p] : a.GetCols();
+    const int v = q < qEnd ? b.GetColIndex()[q] : b.GetCols();
+    const int col = std::min(u, v);
+    const T x = u == col ? a.GetValues()[p++] : T(0);
+    const T y = v == col ? b.GetValues()[q++] : T(0);
+    if (!f(col, x, y)) return false;
+  }
+  return true;
+}
+
+// |x| > drop, NaN included
+TMPL static bool Kept(T x, typename S21Traits<T>::Real drop) {
+  return !(S21Abs(x) <= drop);
+}
+
+//=================   CONSTRUCTORS   ======================
+
+TMPL SPARSE::S21BasicSparseMatrix() : rows_{}, cols_{}, rowPtr_(1) {}
+
+TMPL SPARSE::S21BasicSparseMatrix(int rows, int cols)
+    : rows_(rows), cols_(cols) {
+  if (rows < 1 || cols < 1) throw std::invalid_argument("Can't be less than 1");
+  rowPtr_.assign(rows + 1, 0);
+}
+
+TMPL SPARSE::S21BasicSparseMatrix(const S21BasicMatrix<T> &dense, Real drop)
+    : rows_(dense.rows_), cols_(dense.cols_), rowPtr_(dense.rows_ + 1) {
+  // counted first so the arrays are allocated once, at their final size
+  S21ParallelRows(0, rows_, cols_, [&](int from, int to) {
+    for (int i = from; i < to; ++i) {
+      const T *row = dense.RowPtr(i);
+      rowPtr_[i + 1] = int(std::count_if(
+          row, row + cols_, [drop](T x) { return Kept(x, drop); }));
+    }
+  });
+  std::partial_sum(rowPtr_.begin(), rowPtr_.end(), rowPtr_.begin());
+  colIndex_.resize(rowPtr_[rows_]), values_.resize(rowPtr_[rows_]);
+  S21ParallelRows(0, rows_, cols_, [&](int from, int to) {
+    for (int i = from; i < to; ++i) {
+      const T *row = dense.RowPtr(i);
+      for (int j = 0, at = rowPtr_[i]; j < cols_; j++)
+        if (Kept(row[j], drop)) colIndex_[at] = j, values_[at++] = row[j];
+    }
+  });
+}
+
+TMPL SPARSE::S21BasicSparseMatrix(int rows, int cols, std::vector<int> rowPtr,
+                                  std::vector<int> colIndex,
+                                  std::vector<T> values)
+    : S21BasicSparseMatrix(rows, cols) {
+  bool valid = int(rowPtr.size()) == rows + 1 && rowPtr[0] == 0 &&
+               rowPtr[rows] == int(colIndex.size()) &&
+               colIndex.size() == values.size();
+  for (int i = 0; valid && i < rows; i++) {
+    valid = rowPtr[i] <= rowPtr[i + 1];
+    for (int k = rowPtr[i], last = -1; valid && k < rowPtr[i + 1]; k++)
+      valid = colIndex[k] > last && colIndex[k] < cols, last = colIndex[k];
+  }
+  if (!valid) throw std::invalid_argument("Invalid sparse structure");
+  rowPtr_ = std::move(rowPtr), colIndex_ = std::move(colIndex);
+  values_ = std::move(values);
+}
+
+// the CSC arrays of a matrix are the CSR arrays of its transpose
+TMPL SPARSE SPARSE::FromCsc(int rows, int cols, const std::vector<int> &colPtr,
+                            const std::vector<int> &rowIndex,
+                            const std::vector<T> &values) {
+  return S21BasicSparseMatrix(cols, rows, colPtr, rowIndex, values)
+      .Transpose();
+}
+
+//=================   GET   ======================
+
+TMPL T SPARSE::At(int row, int col) const {
+  if (row < 0 || col < 0)
+    throw std::out_of_range("Less than 0 exception");
+  else if (row >= rows_ || col >= cols_)
+    throw std::out_of_range("Out of bounds exception");
+  const auto begin = colIndex_.begin() + rowPtr_[row],
+             end = colIndex_.begin() + rowPtr_[row + 1],
+             found = std::lower_bound(begin, end, col);
+  return found != end && *found == col ? values_[found - colIndex_.begin()]
+                                       : T(0);
+}
+
+//=================   ARITHMETIC   ======================
+
+TMPL bool SPARSE::EqMatrix(const SPARSE &other) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_) return false;
+  FOR(rows_)
+  if (!ZipRow(*this, other, i, [](int, T x, T y) { return S21Near(x, y); }))
+    return false;
+  return true;
+}
+
+TMPL void SPARSE::SumMatrix(const SPARSE &other) { Merge(other, 1); }
+TMPL void SPARSE::SubMatrix(const SPARSE &other) { Merge(other, -1); }
+
+TMPL void SPARSE::MulNumber(const T num) {
+  S21GetKernels<T>().scale(GetNonZeros(), values_.data(), num);
+}
+
+TMPL void SPARSE::MulMatrix(const SPARSE &other) {
+  *this = Product(*this, other);
+}
+
+TMPL void SPARSE::Merge(const SPARSE &other, int sign) {
+  CheckSizes(other);
+  std::vector<int> rowPtr(rows_ + 1), colIndex;
+  std::vector<T> values;
+  colIndex.reserve(values_.size() + other.values_.size());
+  values.reserve(colIndex.capacity());
+  FOR(rows_) {
+    ZipRow(*this, other, i, [&](int col, T x, T y) {
+      if ((x = sign > 0 ? x + y : x - y) != T(0))
+        colIndex.push_back(col), values.push_back(x);
+      return true;
+    });
+    rowPtr[i + 1] = int(values.size());
+  }
+  rowPtr_.swap(rowPtr), colIndex_.swap(colIndex), values_.swap(values);
+}
+
+//=================   OPERATIONS   ======================
+
+// counting sort by column: rows are visited in order, so every row of the
+// result comes out sorted
+TMPL SPARSE SPARSE::Transpose() const {
+  S21BasicSparseMatrix result;
+  result.rows_ = cols_, result.cols_ = rows_;
+  result.rowPtr_.assign(cols_ + 1, 0);
+  for (int col : colIndex_) ++result.rowPtr_[col + 1];
+  std::partial_sum(result.rowPtr_.begin(), result.rowPtr_.end(),
+                   result.rowPtr_.begin());
+  result.colIndex_.resize(values_.size());
+  result.values_.resize(values_.size());
+  std::vector<int> next(result.rowPtr_.begin(), result.rowPtr_.end() - 1);
+  FOR(rows_)
+  for (int k = rowPtr_[i]; k < rowPtr_[i + 1]; k++) {
+    const int at = next[colIndex_[k]]++;
+    result.colIndex_[at] = i, result.values_[at] = values_[k];
+  }
+  return result;
+}
+
+TMPL S21BasicMatrix<T> SPARSE::ToDense() const {
+  if (!rows_) return S21BasicMatrix<T>();
+  S21BasicMatrix<T> result(rows_, cols_);
+  FOR(rows_)
+  for (int k = rowPtr_[i]; k < rowPtr_[i + 1]; k++)
+    result.RowPtr(i)[colIndex_[k]] = values_[k];
+  return result;
+}
+
+TMPL void SPARSE::ToCsc(std::vector<int> &colPtr, std::vector<int> &rowIndex,
+                        std::vector<T> &values) const {
+  S21BasicSparseMatrix transposed = Transpose();
+  colPtr = std::move(transposed.rowPtr_);
+  rowIndex = std::move(transposed.colIndex_);
+  values = std::move(transposed.values_);
+}
+
+//=================   OPERATOR OVERLOAD   ======================
+
+#define OP TMPL SPARSE &SPARSE::operator
+
+OP += (const S21BasicSparseMatrix &other) { return SumMatrix(other), *this; }
+OP -= (const S21BasicSparseMatrix &other) { return SubMatrix(other), *this; }
+OP *= (const S21BasicSparseMatrix &other) { return MulMatrix(other), *this; }
+OP *= (const T mul) { return MulNumber(mul), *this; }
+
+TMPL bool SPARSE::operator==(const SPARSE &other) const {
+  return EqMatrix(other);
+}
+
+//=================   SUPPLEMENTARY   ======================
+
+TMPL void SPARSE::CheckSizes(const SPARSE &other) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_)
+    throw std::invalid_argument("Unequal size of matrices");
+}
+
+// Gustavson's row-by-row product: a symbolic pass sizes every result row,
+// a numeric pass accumulates it densely and gathers it in column order.
+// Products that cancel stay stored as explicit zeros.
+TMPL SPARSE SPARSE::Product(const SPARSE &lhs, const SPARSE &rhs) {
+  if (lhs.cols_ != rhs.rows_) throw std::invalid_argument("Invalid sizes");
+
+  S21BasicSparseMatrix result;
+  result.rows_ = lhs.rows_, result.cols_ = rhs.cols_;
+  result.rowPtr_.assign(lhs.rows_ + 1, 0);
+  long long flops = 0;
+  for (int k : lhs.colIndex_) flops += rhs.rowPtr_[k + 1] - rhs.rowPtr_[k];
+  const int work = int(std::min<long long>(
+      flops / std::max(lhs.rows_, 1) + 1, S21_PARALLEL_MIN));
+
+  S21ParallelRows(0, lhs.rows_, work, [&](int from, int to) {
+    std::vector<int> mark(rhs.cols_, -1);
+    for (int i = from; i < to; ++i)
+      for (int k = lhs.rowPtr_[i]; k < lhs.rowPtr_[i + 1]; k++)
+        for (int p = rhs.rowPtr_[lhs.colIndex_[k]];
+             p < rhs.rowPtr_[lhs.colIndex_[k] + 1]; p++)
+          if (mark[rhs.colIndex_[p]] != i)
+            mark[rhs.colIndex_[p]] = i, ++result.rowPtr_[i + 1];
+  });
+  std::partial_sum(result.rowPtr_.begin(), result.rowPtr_.end(),
+                   result.rowPtr_.begin());
+  result.colIndex_.resize(result.rowPtr_.back());
+  result.values_.resize(result.rowPtr_.back());
+
+  S21ParallelRows(0, lhs.rows_, work, [&](int from, int to) {
+    std::vector<int> mark(rhs.cols_, -1);
+    std::vector<T> sum(rhs.cols_);
+    for (int i = from; i < to; ++i) {
+      int *cols = result.colIndex_.data() + result.rowPtr_[i], count = 0;
+      for (int k = lhs.rowPtr_[i]; k < lhs.rowPtr_[i + 1]; k++)
+        for (int p = rhs.rowPtr_[lhs.colIndex_[k]];
+             p < rhs.rowPtr_[lhs.colIndex_[k] + 1]; p++) {
+          const int col = rhs.colIndex_[p];
+          if (mark[col] != i)
+            mark[col] = i, sum[col] = T(0), cols[count++] = col;
+          sum[col] += lhs.values_[k] * rhs.values_[p];
+        }
+      std::sort(cols, cols + count);
+      for (int q = 0; q < count; q++)
+        result.values_[result.rowPtr_[i] + q] = sum[cols[q]];
+    }
+  });
+  return result;
+}
+
+// every stored lhs(i, k) adds a scaled row k of rhs to row i
+TMPL S21BasicMatrix<T> SPARSE::Product(const SPARSE &lhs,
+                                       const S21BasicMatrix<T> &rhs) {
+  if (lhs.cols_ != rhs.rows_) throw std::invalid_argument("Invalid sizes");
+
+  S21BasicMatrix<T> result(lhs.rows_, rhs.cols_);
+  const int n = rhs.cols_, work = (lhs.GetNonZeros() / lhs.rows_ + 1) * n;
+  S21ParallelRows(0, lhs.rows_, work, [&](int from, int to) {
+    for (int i = from; i < to; ++i) {
+      T *dst = result.RowPtr(i);
+      for (int k = lhs.rowPtr_[i]; k < lhs.rowPtr_[i + 1]; k++) {
+        const T x = lhs.values_[k], *src = rhs.RowPtr(lhs.colIndex_[k]);
+        for (int j = 0; j < n; j++) dst[j] += x * src[j];
+      }
+    }
+  });
+  return result;
+}
+
+// row i of the result scatters lhs(i, k) * rhs(k, :) over stored entries
+TMPL S21BasicMatrix<T> SPARSE::Product(const S21BasicMatrix<T> &lhs,
+                                       const SPARSE &rhs) {
+  if (lhs.cols_ != rhs.rows_) throw std::invalid_argument("Invalid sizes");
+
+  S21BasicMatrix<T> result(lhs.rows_, rhs.cols_);
+  const int work = rhs.GetNonZeros() + rhs.rows_;
+  S21ParallelRows(0, lhs.rows_, work, [&](int from, int to) {
+    for (int i = from; i < to; ++i) {
+      const T *src = lhs.RowPtr(i);
+      T *dst = result.RowPtr(i);
+      for (int k = 0; k < rhs.rows_; k++)
+        for (int p = rhs.rowPtr_[k]; p < rhs.rowPtr_[k + 1]; p++)
+          dst[rhs.colIndex_[p]] += src[k] * rhs.values_[p];
+    }
+  });
+  return result;
+}
+
+#define INSTANTIATE(T) template class S21BasicSparseMatrix<T>;
+S21_ELEMENT_TYPES(INSTANTIATE)
@@ -0,0 +1,127 @@
+#ifndef S21_SPARSE_MATRIX_H
+#define S21_SPARSE_MATRIX_H
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+//=================   SPARSE MATRICES   ======================
+// Compressed sparse rows: row i holds values_[rowPtr_[i] .. rowPtr_[i + 1])
+// at the ascending columns colIndex_[...]. Storage and every operation
+// scale with the number of stored entries, not rows * cols. The CSC form of
+// a matrix is the CSR form of its transpose.
+
+template <typename T>
+class S21BasicSparseMatrix {
+ public:
+  using Scalar = T;
+  using Real = typename S21Traits<T>::Real;
+
+  //=================  CONSTRUCTORS   ======================
+  S21BasicSparseMatrix();
+  // all zeros
+  S21BasicSparseMatrix(int rows, int cols);
+  // keeps the entries with |x| > drop
+  explicit S21BasicSparseMatrix(const S21BasicMatrix<T>& dense, Real drop = 0);
+  // takes ownership of CSR arrays, checking their shape and column order
+  S21BasicSparseMatrix(int rows, int cols, std::vector<int> rowPtr,
+                       std::vector<int> colIndex, std::vector<T> values);
+  static S21BasicSparseMatrix FromCsc(int rows, int cols,
+                                      const std::vector<int>& colPtr,
+                                      const std::vector<int>& rowIndex,
+                                      const std::vector<T>& values);
+
+  //=================   GET   ======================
+  int GetRows() const { return rows_; }
+  int GetCols() const { return cols_; }
+  int GetNonZeros() const { return int(values_.size()); }
+  const std::vector<int>& GetRowPtr() const { return rowPtr_; }
+  const std::vector<int>& GetColIndex() const { return colIndex_; }
+  const std::vector<T>& GetValues() const { return values_; }
+  // zero where nothing is stored
+  T At(int row, int col) const;
+
+  //=================   ARITHMETIC   ======================
+  bool EqMatrix(const S21BasicSparseMatrix& other) const;
+  void SumMatrix(const S21BasicSparseMatrix& other);
+  void SubMatrix(const S21BasicSparseMatrix& other);
+  void MulNumber(const T num);
+  void MulMatrix(const S21BasicSparseMatrix& other);
+
+  //=================   OPERATIONS   ======================
+  S21BasicSparseMatrix Transpose() const;
+  S21BasicMatrix<T> ToDense() const;
+  void ToCsc(std::vector<int>& colPtr, std::vector<int>& rowIndex,
+             std::vector<T>& values) const;
+
+  //=================   OPERATOR OVERLOAD   ======================
+  bool operator==(const S21BasicSparseMatrix& other) const;
+  S21BasicSparseMatrix& operator+=(const S21BasicSparseMatrix& other);
+  S21BasicSparseMatrix& operator-=(const S21BasicSparseMatrix& other);
+  S21BasicSparseMatrix& operator*=(const S21BasicSparseMatrix& other);
+  S21BasicSparseMatrix& operator*=(const T mul);
+
+  //=================   SUPPLEMENTARY   ======================
+  void CheckSizes(const S21BasicSparseMatrix& other) const;
+  // sparse x sparse, sparse x dense and dense x sparse
+  static S21BasicSparseMatrix Product(const S21BasicSparseMatrix& lhs,
+                                      const S21BasicSparseMatrix& rhs);
+  static S21BasicMatrix<T> Product(const S21BasicSparseMatrix& lhs,
+                                   const S21BasicMatrix<T>& rhs);
+  static S21BasicMatrix<T> Product(const S21BasicMatrix<T>& lhs,
+                                   const S21BasicSparseMatrix& rhs);
+
+ private:
+  // this + sign * other, dropping entries that cancel exactly
+  void Merge(const S21BasicSparseMatrix& other, int sign);
+
+  int rows_, cols_;
+  std::vector<int> rowPtr_, colIndex_;
+  std::vector<T> values_;
+};
+
+using S21SparseMatrix = S21BasicSparseMatrix<double>;
+
+//=================   OPERATORS   ======================
+
+template <typename T>
+S21BasicSparseMatrix<T> operator+(S21BasicSparseMatrix<T> lhs,
+                                  const S21BasicSparseMatrix<T>& rhs) {
+  return lhs += rhs;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> operator-(S21BasicSparseMatrix<T> lhs,
+                                  const S21BasicSparseMatrix<T>& rhs) {
+  return lhs -= rhs;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> operator*(S21BasicSparseMatrix<T> lhs, T num) {
+  return lhs *= num;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> operator*(T num, S21BasicSparseMatrix<T> rhs) {
+  return rhs *= num;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> operator*(const S21BasicSparseMatrix<T>& lhs,
+                                  const S21BasicSparseMatrix<T>& rhs) {
+  return S21BasicSparseMatrix<T>::Product(lhs, rhs);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator*(const S21BasicSparseMatrix<T>& lhs,
+                            const S21BasicMatrix<T>& rhs) {
+  return S21BasicSparseMatrix<T>::Product(lhs, rhs);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator*(const S21BasicMatrix<T>& lhs,
+                            const S21BasicSparseMatrix<T>& rhs) {
+  return S21BasicSparseMatrix<T>::Product(lhs, rhs);
+}
+
+#endif  // S21_SPARSE_MATRIX_H
@@ -0,0 +1,143 @@
+#include "s21_thread_pool.h"
+
+#include <algorithm>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+static thread_local int tLimit = 0;
+static thread_local bool tInPool = false;
+
+//=================   THREAD POOL   ======================
+
+S21ThreadPool& S21ThreadPool::Instance() {
+  static S21ThreadPool pool;
+  return pool;
+}
+
+S21ThreadPool::S21ThreadPool()
+    : threads_(1),
+      generation_(0),
+      stop_(false),
+      active_(0),
+      pending_(0),
+      body_{},
+      begin_(0),
+      end_(0),
+      chunk_(1),
+      next_(0) {
+  Start(0);
+}
+
+S21ThreadPool::~S21ThreadPool() { Stop(); }
+
+int S21ThreadPool::GetThreads() const { return threads_; }
+
+void S21ThreadPool::SetThreads(int threads) {
+  std::lock_guard<std::mutex> owner(run_);
+  Stop(), Start(threads);
+}
+
+void S21ThreadPool::SetAffinity(const std::vector<int>& cores) {
+  std::lock_guard<std::mutex> owner(run_);
+  const int threads = threads_;
+  Stop(), cores_ = cores, Start(threads);
+}
+
+void S21ThreadPool::Start(int threads) {
+  if (threads < 1) threads = std::max(1u, std::thread::hardware_concurrency());
+  stop_ = false, threads_ = threads;
+  for (int i = 1; i < threads; ++i)
+    workers_.emplace_back(&S21ThreadPool::Worker, this, i, generation_);
+}
+
+void S21ThreadPool::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (std::thread& worker : workers_) worker.join();
+  workers_.clear(), threads_ = 1;
+}
+
+void S21ThreadPool::Pin(int index) const {
+#ifdef __linux__
+  if (cores_.empty()) return;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cores_[index % cores_.size()], &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+  (void)index;
+#endif
+}
+
+void S21ThreadPool::Worker(int index, unsigned seen) {
+  Pin(index), tInPool = true;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+      if (stop_) return;
+      seen = generation_;
+      if (index > active_) continue;
+    }
+    RunChunks();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--pending_ == 0) done_.notify_one();
+  }
+}
+
+void S21ThreadPool::RunChunks() {
+  const int chunks = (end_ - begin_ + chunk_ - 1) / chunk_;
+  for (int c; (c = next_.fetch_add(1)) < chunks;) {
+    const int from = begin_ + c * chunk_, to = std::min(end_, from + chunk_);
+    try {
+      body_.call(body_.object, from, to);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!error_) error_ = std::current_exception();
+    }
+  }
+}
+
+void S21ThreadPool::Run(int begin, int end, int grain, Body body) {
+  const int n = end - begin;
+  grain = std::max(grain, 1);
+  if (n <= 0) return;
+  if (tInPool || n <= grain) return body.call(body.object, begin, end);
+  std::unique_lock<std::mutex> owner(run_, std::try_to_lock);
+  const int chunks =
+      std::min(S21Parallelism::Current(), (n + grain - 1) / grain);
+  if (!owner || chunks <= 1) return body.call(body.object, begin, end);
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    body_ = body, begin_ = begin, end_ = end;
+    chunk_ = (n + chunks - 1) / chunks;
+    next_ = 0, error_ = nullptr, active_ = pending_ = chunks - 1, ++generation_;
+  }
+  wake_.notify_all();
+  tInPool = true, RunChunks(), tInPool = false;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [&] { return pending_ == 0; });
+  }
+  if (error_) std::rethrow_exception(error_);
+}
+
+//=================   PARALLELISM POLICY   ======================
+
+S21Parallelism::S21Parallelism(int threads) : previous_(tLimit) {
+  tLimit = std::max(threads, 1);
+}
+
+S21Parallelism::~S21Parallelism() { tLimit = previous_; }
+
+int S21Parallelism::Current() {
+  const int threads = S21ThreadPool::Instance().GetThreads();
+  return tLimit ? std::min(tLimit, threads) : threads;
+}
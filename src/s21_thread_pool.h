@@ -0,0 +1,98 @@
+#ifndef S21_THREAD_POOL_H
+#define S21_THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// below this many scalar operations per chunk a loop stays on one thread
+#define S21_PARALLEL_MIN (1 << 15)
+
+//=================   THREAD POOL   ======================
+// Library-wide workers shared by every S21Matrix operation. The calling
+// thread always takes part, so SetThreads(n) starts n - 1 workers.
+
+class S21ThreadPool {
+ public:
+  static S21ThreadPool& Instance();
+  ~S21ThreadPool();
+
+  int GetThreads() const;
+  void SetThreads(int threads);  // 0 means one per hardware thread
+  // worker i (1-based, the caller is left alone) is pinned to
+  // cores[i % size]; an empty list unpins
+  void SetAffinity(const std::vector<int>& cores);
+
+  // Splits [begin, end) into chunks of at least grain items and runs
+  // body(from, to) on them. Serial when one chunk suffices, when called
+  // from inside the pool, or when another thread already owns the pool.
+  // The body is only referenced, so dispatch never allocates.
+  template <typename F>
+  void ParallelFor(int begin, int end, int grain, const F& body) {
+    Run(begin, end, grain, {&body, [](const void* f, int from, int to) {
+                              (*static_cast<const F*>(f))(from, to);
+                            }});
+  }
+
+ private:
+  S21ThreadPool();
+  S21ThreadPool(const S21ThreadPool&) = delete;
+  S21ThreadPool& operator=(const S21ThreadPool&) = delete;
+
+  struct Body {
+    const void* object;
+    void (*call)(const void* object, int from, int to);
+  };
+
+  void Run(int begin, int end, int grain, Body body);
+  void Start(int threads);
+  void Stop();
+  void Worker(int index, unsigned seen);
+  void RunChunks();
+  void Pin(int index) const;
+
+  std::vector<std::thread> workers_;
+  std::vector<int> cores_;
+  std::atomic<int> threads_;
+  std::mutex mutex_, run_;
+  std::condition_variable wake_, done_;
+  unsigned generation_;
+  bool stop_;
+  int active_, pending_;
+
+  Body body_;
+  int begin_, end_, chunk_;
+  std::atomic<int> next_;
+  std::exception_ptr error_;
+};
+
+// ParallelFor over rows (or any items) costing work scalar operations each,
+// so every chunk carries at least S21_PARALLEL_MIN of them
+template <typename F>
+void S21ParallelRows(int from, int to, int work, const F& body) {
+  S21ThreadPool::Instance().ParallelFor(
+      from, to, S21_PARALLEL_MIN / std::max(work, 1), body);
+}
+
+//=================   PARALLELISM POLICY   ======================
+// Caps the threads used by operations issued from this thread while the
+// object lives, e.g. S21Parallelism serial(1) for a latency-bound call.
+
+class S21Parallelism {
+ public:
+  explicit S21Parallelism(int threads);
+  ~S21Parallelism();
+  S21Parallelism(const S21Parallelism&) = delete;
+  S21Parallelism& operator=(const S21Parallelism&) = delete;
+
+  static int Current();
+
+ private:
+  int previous_;
+};
+
+#endif  // S21_THREAD_POOL_H
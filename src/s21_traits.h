@@ -0,0 +1,90 @@
+#ifndef S21_TRAITS_H
+#define S21_TRAITS_H
+
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <type_traits>
+
+//=================   ELEMENT TYPES   ======================
+// Every element type the library is built for; each translation unit
+// instantiates its templates once per entry.
+#define S21_ELEMENT_TYPES(X) \
+  X(float) X(double) X(std::int64_t) X(std::complex<double>)
+// the inexact ones, for factorizations that divide
+#define S21_FLOATING_TYPES(X) X(float) X(double) X(std::complex<double>)
+// the real floating ones, for orthogonal transformations
+#define S21_REAL_TYPES(X) X(float) X(double)
+
+//=================   TOLERANCE TRAITS   ======================
+// Two elements are unequal once |a - b| reaches kEps. Integers are exact:
+// kEps is one unit. kDtype tags the type in saved files.
+
+template <typename T>
+struct S21Traits;
+
+template <>
+struct S21Traits<float> {
+  static constexpr int kDtype = 1;
+  using Real = float;
+  static constexpr bool kExact = false;
+  static constexpr Real kEps = 1.0e-5f;
+};
+
+template <>
+struct S21Traits<double> {
+  static constexpr int kDtype = 2;
+  using Real = double;
+  static constexpr bool kExact = false;
+  static constexpr Real kEps = 1.0e-7;
+};
+
+template <>
+struct S21Traits<std::int64_t> {
+  static constexpr int kDtype = 3;
+  using Real = std::int64_t;
+  static constexpr bool kExact = true;
+  static constexpr Real kEps = 1;
+};
+
+template <>
+struct S21Traits<std::complex<double>> {
+  static constexpr int kDtype = 4;
+  using Real = double;
+  static constexpr bool kExact = false;
+  static constexpr Real kEps = 1.0e-7;
+};
+
+template <typename T>
+typename S21Traits<T>::Real S21Abs(T x) {
+  return std::abs(x);
+}
+
+// conj(x) for complex types, x itself for the others
+template <typename T>
+T S21Conj(T x) {
+  if constexpr (std::is_same_v<T, std::complex<typename S21Traits<T>::Real>>)
+    return std::conj(x);
+  else
+    return x;
+}
+
+// a NaN difference compares near, as the vector kernels' ordered >= does
+template <typename T>
+bool S21Near(T a, T b) {
+  return !(S21Abs(a - b) >= S21Traits<T>::kEps);
+}
+
+// A pivot of an n x n elimination within n * epsilon * scale of zero,
+// scale being the largest |entry| of the matrix, is rounding noise and the
+// matrix numerically singular. Relative, so a small determinant alone
+// (0.5 * I of size 100) is no sign of it; integers need an exact zero.
+template <typename T>
+bool S21NegligiblePivot(T pivot, int n, typename S21Traits<T>::Real scale) {
+  using Real = typename S21Traits<T>::Real;
+  return S21Abs(pivot) <= n * std::numeric_limits<Real>::epsilon() * scale;
+}
+
+#endif  // S21_TRAITS_H
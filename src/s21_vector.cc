@@ -0,0 +1,102 @@
+#include "s21_vector.h"
+
+#include "s21_simd.h"
+#include "s21_thread_pool.h"
+
+#define TMPL template <typename T>
+#define MAT S21BasicMatrix<T>
+#define VECTOR S21BasicVector<T>
+// columns of y kept hot while every row adds into them
+#define VECTOR_BLOCK 2048
+
+//=================  CONSTRUCTORS   ======================
+
+TMPL VECTOR::S21BasicVector(S21BasicMatrixView<const T> view)
+    : S21BasicVector(view.GetRows() == 1 ? view.GetCols() : view.GetRows()) {
+  if (view.GetRows() != 1 && view.GetCols() != 1)
+    throw std::invalid_argument("Not a single row or column");
+  AsRow().Assign(view.GetRows() == 1 ? view : view.Transposed());
+}
+
+//=================   ARITHMETIC   ======================
+
+TMPL bool VECTOR::EqVector(const VECTOR &other) const {
+  return GetSize() == other.GetSize() && data_.EqMatrix(other.data_);
+}
+
+TMPL void VECTOR::SumVector(const VECTOR &other) {
+  CheckSizes(other), data_.SumMatrix(other.data_);
+}
+
+TMPL void VECTOR::SubVector(const VECTOR &other) {
+  CheckSizes(other), data_.SubMatrix(other.data_);
+}
+
+TMPL void VECTOR::MulNumber(const T num) { data_.MulNumber(num); }
+
+TMPL T VECTOR::Dot(const VECTOR &other) const {
+  CheckSizes(other);
+  return S21GetKernels<T>().dot(GetSize(), Data(), other.Data());
+}
+
+TMPL void VECTOR::Axpy(const T alpha, const VECTOR &other) {
+  CheckSizes(other);
+  S21GetKernels<T>().axpy(GetSize(), Data(), other.Data(), alpha);
+}
+
+//=================   MATRIX PRODUCTS   ======================
+
+TMPL VECTOR MAT::Mul(const VECTOR &x) const {
+  VECTOR y;
+  return Mul(x, y), y;
+}
+
+TMPL VECTOR MAT::MulTransposed(const VECTOR &x) const {
+  VECTOR y;
+  return MulTransposed(x, y), y;
+}
+
+// one dot product per row, rows split across the pool
+TMPL void MAT::Mul(const VECTOR &x, VECTOR &y) const {
+  S21_PROFILE_SCOPE(Mul);
+  if (x.GetSize() != cols_) throw std::invalid_argument("Invalid sizes");
+  if (&x == &y) return void(y = Mul(x));
+  if (y.GetSize() != rows_) y = VECTOR(rows_);
+  const S21Kernels<T> &kernels = S21GetKernels<T>();
+  const T *in = x.Data();
+  T *out = y.Data();
+  S21ParallelRows(0, rows_, cols_, [&](int from, int to) {
+    for (int i = from; i < to; ++i) out[i] = kernels.dot(cols_, RowPtr(i), in);
+  });
+}
+
+// y accumulates x[i] times row i, so the rows stay contiguous reads; each
+// thread owns a slice of columns and walks it in cache-sized blocks
+TMPL void MAT::MulTransposed(const VECTOR &x, VECTOR &y) const {
+  S21_PROFILE_SCOPE(MulTransposed);
+  if (x.GetSize() != rows_) throw std::invalid_argument("Invalid sizes");
+  if (&x == &y) return void(y = MulTransposed(x));
+  if (y.GetSize() != cols_) y = VECTOR(cols_);
+  const S21Kernels<T> &kernels = S21GetKernels<T>();
+  const T *in = x.Data();
+  T *out = y.Data();
+  S21ParallelRows(0, cols_, rows_, [&](int from, int to) {
+    for (int j = from; j < to; j += VECTOR_BLOCK) {
+      const int n = std::min(VECTOR_BLOCK, to - j);
+      std::fill_n(out + j, n, T());
+      FOR(rows_) kernels.axpy(n, out + j, RowPtr(i) + j, in[i]);
+    }
+  });
+}
+
+#define INSTANTIATE(T)                                                   \
+  template class S21BasicVector<T>;                                      \
+  template S21BasicVector<T> S21BasicMatrix<T>::Mul(                     \
+      const S21BasicVector<T> &) const;                                  \
+  template S21BasicVector<T> S21BasicMatrix<T>::MulTransposed(           \
+      const S21BasicVector<T> &) const;                                  \
+  template void S21BasicMatrix<T>::Mul(const S21BasicVector<T> &,        \
+                                       S21BasicVector<T> &) const;       \
+  template void S21BasicMatrix<T>::MulTransposed(                        \
+      const S21BasicVector<T> &, S21BasicVector<T> &) const;
+S21_ELEMENT_TYPES(INSTANTIATE)
@@ -0,0 +1,117 @@
+#ifndef S21_VECTOR_H
+#define S21_VECTOR_H
+
+#include "s21_matrix_oop.h"
+
+//=================   VECTORS   ======================
+// One contiguous, aligned run of elements. Products with a matrix read each
+// matrix row once through the dot and axpy kernels instead of building an
+// n x 1 matrix for MulMatrix, and the forms of S21BasicMatrix::Mul taking
+// an output vector reuse its storage, so an iteration allocates nothing.
+
+template <typename T>
+class S21BasicVector {
+ public:
+  using Scalar = T;
+
+  //=================  CONSTRUCTORS   ======================
+  S21BasicVector() = default;
+  // size zero elements
+  explicit S21BasicVector(int size) : data_(1, size) {}
+  // copy of a single row or column
+  explicit S21BasicVector(S21BasicMatrixView<const T> view);
+
+  //=================   GET/SET   ======================
+  int GetSize() const { return data_.GetCols(); }
+  // keeps the leading elements, zero-fills the rest; a default vector has
+  // no row for SetCols to widen, so it starts afresh
+  void SetSize(int size) {
+    if (data_.GetRows())
+      data_.SetCols(size);
+    else
+      *this = S21BasicVector(size);
+  }
+  T* Data() { return data_.matrix_; }
+  const T* Data() const { return data_.matrix_; }
+
+  //=================   ARITHMETIC   ======================
+  bool EqVector(const S21BasicVector& other) const;
+  void SumVector(const S21BasicVector& other);
+  void SubVector(const S21BasicVector& other);
+  void MulNumber(const T num);
+  // sum of x[i] * other[i], without conjugation
+  T Dot(const S21BasicVector& other) const;
+  // this += alpha * other
+  void Axpy(const T alpha, const S21BasicVector& other);
+
+  //=================   VIEWS   ======================
+  S21BasicMatrixView<T> AsRow() { return data_.Row(0); }
+  S21BasicMatrixView<const T> AsRow() const { return data_.Row(0); }
+  S21BasicMatrixView<T> AsCol() { return AsRow().Transposed(); }
+  S21BasicMatrixView<const T> AsCol() const { return AsRow().Transposed(); }
+
+  //=================   OPERATOR OVERLOAD   ======================
+  bool operator==(const S21BasicVector& other) const {
+    return EqVector(other);
+  }
+  S21BasicVector& operator+=(const S21BasicVector& other) {
+    return SumVector(other), *this;
+  }
+  S21BasicVector& operator-=(const S21BasicVector& other) {
+    return SubVector(other), *this;
+  }
+  S21BasicVector& operator*=(const T mul) { return MulNumber(mul), *this; }
+  T& operator()(int index) { return Data()[Checked(index)]; }
+  T operator()(int index) const { return Data()[Checked(index)]; }
+
+  //=================   SUPPLEMENTARY   ======================
+  void CheckSizes(const S21BasicVector& other) const {
+    if (GetSize() != other.GetSize())
+      throw std::invalid_argument("Unequal size of vectors");
+  }
+
+ private:
+  int Checked(int index) const {
+    if (index < 0) throw std::out_of_range("Less than 0 exception");
+    if (index >= GetSize()) throw std::out_of_range("Out of bounds exception");
+    return index;
+  }
+
+  // a single row
+  S21BasicMatrix<T> data_;
+};
+
+using S21Vector = S21BasicVector<double>;
+using S21VectorF = S21BasicVector<float>;
+
+//=================   OPERATORS   ======================
+
+template <typename T>
+S21BasicVector<T> operator+(S21BasicVector<T> lhs,
+                            const S21BasicVector<T>& rhs) {
+  return lhs += rhs;
+}
+
+template <typename T>
+S21BasicVector<T> operator-(S21BasicVector<T> lhs,
+                            const S21BasicVector<T>& rhs) {
+  return lhs -= rhs;
+}
+
+template <typename T>
+S21BasicVector<T> operator*(S21BasicVector<T> lhs, T num) {
+  return lhs *= num;
+}
+
+template <typename T>
+S21BasicVector<T> operator*(T num, S21BasicVector<T> rhs) {
+  return rhs *= num;
+}
+
+template <typename T>
+S21BasicVector<T> operator*(const S21BasicMatrix<T>& lhs,
+                            const S21BasicVector<T>& rhs) {
+  return lhs.Mul(rhs);
+}
+
+#endif  // S21_VECTOR_H
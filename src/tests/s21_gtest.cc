@@ -1,6 +1,20 @@
+#include <sstream>
+
 #include <gtest/gtest.h>
 
 #include "../s21_matrix_oop.h"
+#include "../s21_cholesky.h"
+#include "../s21_eigen.h"
+#include "../s21_fixed_matrix.h"
+#include "../s21_gemm.h"
+#include "../s21_lu.h"
+#include "../s21_matrix_batch.h"
+#include "../s21_profile.h"
+#include "../s21_qr.h"
+#include "../s21_simd.h"
+#include "../s21_sparse_matrix.h"
+#include "../s21_thread_pool.h"
+#include "../s21_vector.h"
 
 TEST(ParametrizedConstructor, test1) {
   EXPECT_ANY_THROW({ S21Matrix test = S21Matrix(3, 0); });
@@ -223,6 +237,90 @@ TEST(EqMatrixTest, UnequalSizes) {
   EXPECT_FALSE(mat2.EqMatrix(mat1));
 }
 
+TEST(SimdKernels, MatchScalar) {
+  const S21Kernels<double> *scalar = S21KernelsFor(kS21Scalar);
+  ASSERT_NE(scalar, nullptr);
+  EXPECT_NE(S21GetKernels().name, nullptr);
+
+  const int size = 37;
+  double src[size], expected[size], actual[size];
+  for (int i = 0; i < size; i++) src[i] = i * 0.5 - 7;
+
+  for (S21Isa isa : {kS21Sse2, kS21Avx2, kS21Avx512}) {
+    const S21Kernels<double> *kernels = S21KernelsFor(isa);
+    if (!kernels) continue;
+    for (int i = 0; i < size; i++) expected[i] = actual[i] = i * 1.25;
+    scalar->add(size, expected, src), kernels->add(size, actual, src);
+    scalar->sub(size - 3, expected, src), kernels->sub(size - 3, actual, src);
+    scalar->scale(size, expected, -3), kernels->scale(size, actual, -3);
+    scalar->axpy(size, expected, src, 0.5);
+    kernels->axpy(size, actual, src, 0.5);
+    for (int i = 0; i < size; i++) EXPECT_EQ(actual[i], expected[i]);
+    EXPECT_NEAR(kernels->dot(size, actual, src),
+                scalar->dot(size, expected, src), 1e-9);
+
+    EXPECT_TRUE(kernels->equal(size, actual, expected, EPS));
+    actual[size - 1] += 1e-6;
+    EXPECT_FALSE(kernels->equal(size, actual, expected, EPS));
+    actual[size - 1] = expected[size - 1], actual[3] -= 1e-6;
+    EXPECT_FALSE(kernels->equal(size, actual, expected, EPS));
+    actual[3] = NAN;
+    EXPECT_EQ(kernels->equal(size, actual, expected, EPS),
+              scalar->equal(size, actual, expected, EPS));
+
+    double tile[size * size], reference[size * size];
+    kernels->transpose(5, 7, src, 7, tile, 5);
+    scalar->transpose(5, 7, src, 7, reference, 5);
+    for (int i = 0; i < 35; i++) EXPECT_EQ(tile[i], reference[i]);
+  }
+}
+
+TEST(SimdKernels, FloatMatchScalar) {
+  const S21Kernels<float> *scalar = S21KernelsFor<float>(kS21Scalar);
+  ASSERT_NE(scalar, nullptr);
+  const float eps = S21Traits<float>::kEps;
+
+  const int size = 37;
+  float src[size * size], expected[size], actual[size];
+  for (int i = 0; i < size * size; i++) src[i] = i * 0.5f - 7;
+
+  for (S21Isa isa : {kS21Sse2, kS21Avx2, kS21Avx512}) {
+    const S21Kernels<float> *kernels = S21KernelsFor<float>(isa);
+    if (!kernels) continue;
+    for (int i = 0; i < size; i++) expected[i] = actual[i] = i * 1.25f;
+    scalar->add(size, expected, src), kernels->add(size, actual, src);
+    scalar->sub(size - 3, expected, src), kernels->sub(size - 3, actual, src);
+    scalar->scale(size, expected, -3), kernels->scale(size, actual, -3);
+    for (int i = 0; i < size; i++) EXPECT_EQ(actual[i], expected[i]);
+
+    EXPECT_TRUE(kernels->equal(size, actual, expected, eps));
+    actual[size - 1] += 1e-3f;
+    EXPECT_FALSE(kernels->equal(size, actual, expected, eps));
+
+    float tile[size * size], reference[size * size];
+    kernels->transpose(9, 11, src, 11, tile, 9);
+    scalar->transpose(9, 11, src, 11, reference, 9);
+    for (int i = 0; i < 99; i++) EXPECT_EQ(tile[i], reference[i]);
+  }
+  EXPECT_EQ(S21KernelsFor<std::int64_t>(kS21Avx2), nullptr);
+}
+
+TEST(EqMatrixTest, WideRowsLastElement) {
+  S21Matrix first(3, 45), second(3, 45);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 45; j++) {
+      first(i, j) = second(i, j) = i * j;
+    }
+  }
+  EXPECT_TRUE(first.EqMatrix(second));
+  second(2, 44) += 1e-3;
+  EXPECT_FALSE(first.EqMatrix(second));
+  first.SumMatrix(second);
+  first.SubMatrix(second);
+  first.MulNumber(2);
+  EXPECT_DOUBLE_EQ(first(1, 7), 14);
+}
+
 TEST(SumMatrixTest, Addition) {
   double matrix1[2][2] = {{1, 2}, {3, 4}};
   double matrix2[2][2] = {{5, 6}, {7, 8}};
@@ -511,6 +609,61 @@ TEST(MulMatrixTest, MultiplyMatrixThrow) {
   EXPECT_ANY_THROW({ mat1.MulMatrix(mat2); });
 }
 
+TEST(MulMatrixTest, BlockedRectangular) {
+  const int rows = 131, inner = 300, cols = 77;
+  S21Matrix first(rows, inner);
+  S21Matrix second(inner, cols);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < inner; j++) {
+      first(i, j) = (i * 7 + j * 3) % 11 - 5;
+    }
+  }
+  for (int i = 0; i < inner; i++) {
+    for (int j = 0; j < cols; j++) {
+      second(i, j) = (i * 5 + j) % 13 - 6;
+    }
+  }
+
+  S21Matrix result = first * second;
+  ASSERT_EQ(result.GetRows(), rows);
+  ASSERT_EQ(result.GetCols(), cols);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) {
+      double expected = 0;
+      for (int k = 0; k < inner; k++) expected += first(i, k) * second(k, j);
+      EXPECT_EQ(result(i, j), expected);
+    }
+  }
+}
+
+TEST(MulMatrixTest, StrassenMatchesClassical) {
+  const int crossover = S21GetStrassenCrossover();
+  S21SetStrassenCrossover(16);
+
+  for (int size : {64, 67}) {
+    const int rows = size, inner = size - 3, cols = size + 5;
+    S21Matrix first(rows, inner), second(inner, cols);
+    for (int i = 0; i < rows; i++) {
+      for (int j = 0; j < inner; j++) first(i, j) = (i * 7 + j * 3) % 11 - 5;
+    }
+    for (int i = 0; i < inner; i++) {
+      for (int j = 0; j < cols; j++) second(i, j) = (i * 5 + j) % 13 - 6;
+    }
+
+    S21Matrix fast = first * second, classical;
+    {
+      S21NoStrassen exact;
+      classical = first * second;
+    }
+    for (int i = 0; i < rows; i++) {
+      for (int j = 0; j < cols; j++) EXPECT_EQ(fast(i, j), classical(i, j));
+    }
+  }
+
+  S21SetStrassenCrossover(crossover);
+  EXPECT_EQ(S21GetStrassenCrossover(), GEMM_STRASSEN);
+}
+
 TEST(test_functional, inverse_3x3_3) {
   const int size = 3;
   S21Matrix given(size, size);
@@ -568,6 +721,51 @@ TEST(test_functional, check_bounds_throws_for_out_of_range_indices) {
 }
 
 
+TEST(test_functional, inverse_large_tridiagonal) {
+  const int size = 150;
+  S21Matrix given(size, size);
+  for (int i = 0; i < size; i++) {
+    given(i, i) = 4;
+    if (i > 0) given(i, i - 1) = -1;
+    if (i + 1 < size) given(i, i + 1) = 2;
+  }
+
+  S21Matrix identity(size, size);
+  for (int i = 0; i < size; i++) identity(i, i) = 1;
+
+  const S21Matrix& constant = given;
+  S21Matrix inverse = constant.InverseMatrix();
+  ASSERT_TRUE(given * inverse == identity);
+  ASSERT_TRUE(inverse * given == identity);
+}
+
+TEST(test_functional, inverse_1x1) {
+  S21Matrix given(1, 1);
+  given(0, 0) = 4;
+  ASSERT_DOUBLE_EQ(given.InverseMatrix()(0, 0), 0.25);
+}
+
+// singularity is judged per pivot against the largest entry, not by |det|
+TEST(test_functional, inverse_small_scale) {
+  S21Matrix half(100, 100), small(3, 3), covariance(200, 200);
+  for (int i = 0; i < 100; i++) half(i, i) = 0.5;
+  for (int i = 0; i < 3; i++) small(i, i) = 1e-3;
+  for (int i = 0; i < 200; i++) {
+    covariance(i, i) = 1e-2;
+    if (i > 0) covariance(i, i - 1) = covariance(i - 1, i) = 2e-3;
+  }
+  ASSERT_DOUBLE_EQ(half.InverseMatrix()(99, 99), 2);
+  ASSERT_DOUBLE_EQ(small.InverseMatrix()(2, 2), 1e3);
+  S21Matrix identity(200, 200);
+  for (int i = 0; i < 200; i++) identity(i, i) = 1;
+  ASSERT_TRUE(covariance * covariance.InverseMatrix() == identity);
+
+  S21Matrix rankTwo(3, 3);
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++) rankTwo(i, j) = (3 * i + j + 1) * 1e-9;
+  ASSERT_THROW(rankTwo.InverseMatrix(), std::logic_error);
+}
+
 TEST(TransposeTest, SquareMatrix) {
   double matrix[3][3] = {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
   double expected[3][3] = {{1, 4, 7}, {2, 5, 8}, {3, 6, 9}};
@@ -642,6 +840,40 @@ TEST(TransposeTest, NonSquareMatrix) {
   }
 }
 
+TEST(TransposeTest, TiledRectangular) {
+  const int rows = 75, cols = 130;
+  S21Matrix mat(rows, cols);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) mat(i, j) = i * 1000 + j;
+  }
+
+  S21Matrix transposed = mat.Transpose();
+  ASSERT_EQ(transposed.GetRows(), cols);
+  ASSERT_EQ(transposed.GetCols(), rows);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) EXPECT_EQ(transposed(j, i), mat(i, j));
+  }
+}
+
+TEST(TransposeTest, InPlaceSquare) {
+  for (int size : {1, 5, 32, 70}) {
+    S21Matrix mat(size, size);
+    for (int i = 0; i < size; i++) {
+      for (int j = 0; j < size; j++) mat(i, j) = i * 1000 + j;
+    }
+    double *buffer = &mat(0, 0);
+
+    mat.TransposeInPlace();
+    EXPECT_EQ(&mat(0, 0), buffer);
+    for (int i = 0; i < size; i++) {
+      for (int j = 0; j < size; j++) EXPECT_EQ(mat(i, j), j * 1000 + i);
+    }
+  }
+
+  S21Matrix rectangular(2, 3);
+  EXPECT_THROW(rectangular.TransposeInPlace(), std::logic_error);
+}
+
 TEST(CalcComplementsTest, SquareMatrix) {
   double matrix[3][3] = {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
   double expected[3][3] = {{-3, 6, -3}, {6, -12, 6}, {-3, 6, -3}};
@@ -675,6 +907,35 @@ TEST(CalcComplementsTest, NonSquareMatrix) {
   EXPECT_THROW(S21Matrix complements = mat.CalcComplements(), std::logic_error);
 }
 
+TEST(CalcComplementsTest, AdjugateMatchesMinors) {
+  const int size = 12;
+  S21Matrix regular(size, size), rankOne(size, size), rankTwo(size, size);
+  for (int i = 0; i < size; i++) {
+    for (int j = 0; j < size; j++) {
+      regular(i, j) = ((i * 7 + j * 3) % 11) / 11.0 + (i == j) * 2;
+      rankTwo(i, j) = (i + 1) * (j % 3 + 1) + (i % 2) * (j + 1);
+    }
+  }
+  // last row repeats the first one, so the rank is size - 1
+  rankOne = regular;
+  for (int j = 0; j < size; j++) rankOne(size - 1, j) = regular(0, j);
+
+  for (const S21Matrix *mat : {&regular, &rankOne}) {
+    S21Matrix expected(size, size);
+    mat->FindComplements(expected);
+    S21Matrix complements = mat->CalcComplements();
+    for (int i = 0; i < size; i++) {
+      for (int j = 0; j < size; j++) {
+        EXPECT_NEAR(complements(i, j), expected(i, j),
+                    1e-9 * (1 + fabs(expected(i, j))));
+      }
+    }
+  }
+
+  S21Matrix zeros(size, size);
+  EXPECT_TRUE(rankTwo.CalcComplements() == zeros);
+}
+
 TEST(DeterminantTest, SingleElementMatrix) {
   double matrix[1][1] = {{5}};
 
@@ -728,6 +989,28 @@ TEST(DeterminantTest, NonSquareMatrix) {
   EXPECT_THROW(mat.Determinant(), std::logic_error);
 }
 
+TEST(DeterminantTest, LargeRankOneUpdate) {
+  const int size = 200;
+  S21Matrix mat = S21Matrix(size, size);
+  for (int i = 0; i < mat.GetRows(); i++) {
+    for (int j = 0; j < mat.GetCols(); j++) {
+      mat(i, j) = (i == j) + 1.0;
+    }
+  }
+
+  EXPECT_NEAR(mat.Determinant(), size + 1, 1e-6);
+}
+
+TEST(DeterminantTest, LargePermutation) {
+  const int size = 6;
+  S21Matrix mat = S21Matrix(size, size);
+  for (int i = 0; i < mat.GetRows(); i++) {
+    mat(i, size - 1 - i) = i + 1;
+  }
+
+  EXPECT_NEAR(mat.Determinant(), -720, EPS);
+}
+
 TEST(OperatorEqual, test1) {
   EXPECT_NO_THROW({
     S21Matrix check = S21Matrix(3, 4);
@@ -847,6 +1130,35 @@ TEST(OperatorMultNum, test1) {
   ASSERT_TRUE((matrix_a * 10) == result);
 }
 
+TEST(ExpressionTemplates, FusedChain) {
+  S21Matrix a(3, 4), b(3, 4), c(3, 4), square(4, 4);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 4; j++) {
+      a(i, j) = i + j, b(i, j) = i * j, c(i, j) = i - j;
+      square(j, i) = (i == j);
+    }
+  }
+  square(3, 3) = 1;
+
+  S21Matrix result = a + b - c * 2.0 + 0.5 * (a - b);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 4; j++) {
+      EXPECT_DOUBLE_EQ(result(i, j), a(i, j) + b(i, j) - c(i, j) * 2.0 +
+                                         0.5 * (a(i, j) - b(i, j)));
+    }
+  }
+
+  auto lazy = a * square + (b - c) * square;
+  result = lazy;
+  EXPECT_TRUE(lazy == a + b - c);
+  EXPECT_TRUE(result == a + b - c);
+
+  a = a + a * 3;
+  EXPECT_DOUBLE_EQ(a(2, 3), 20);
+  EXPECT_THROW(S21Matrix bad = a + square, std::invalid_argument);
+  EXPECT_THROW(S21Matrix bad = (a - b) * (b + c), std::invalid_argument);
+}
+
 TEST(OperatorMultMatrix, test1) {
   S21Matrix matrix1(2, 3);
   matrix1(0, 0) = 1.0;
@@ -1078,6 +1390,57 @@ TEST(OperatorMoveAssignment, SelfMoveAssignment) {
   }
 }
 
+TEST(OperatorMoveAssignment, StealsBuffer) {
+  S21Matrix source(4, 5), target(2, 2);
+  source(3, 4) = 7;
+  double *buffer = &source(0, 0);
+
+  target = std::move(source);
+  EXPECT_EQ(&target(0, 0), buffer);
+  EXPECT_EQ(target.GetRows(), 4);
+  EXPECT_EQ(target(3, 4), 7);
+  EXPECT_EQ(source.GetRows(), 0);
+  EXPECT_EQ(source.GetCols(), 0);
+}
+
+TEST(OperatorMoveAssignment, ExpiringOperandReused) {
+  S21Matrix a(3, 3), b(3, 3);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      a(i, j) = i, b(i, j) = j;
+    }
+  }
+  double *buffer = &a(0, 0);
+
+  S21Matrix sum = b * 2.0 + std::move(a) - b;
+  EXPECT_EQ(&sum(0, 0), buffer);
+  EXPECT_EQ(sum(2, 1), 3);
+
+  S21Matrix product = b * b;
+  buffer = &product(0, 0);
+  S21Matrix shifted(1, 1);
+  shifted = std::move(product) - b;
+  EXPECT_EQ(&shifted(0, 0), buffer);
+  buffer = &sum(0, 0);
+  sum = b * b + b;
+  EXPECT_EQ(&sum(0, 0), buffer);
+  EXPECT_TRUE(sum - shifted == b * 2.0);
+}
+
+TEST(OperatorPlusEqual, InPlaceReturnsReference) {
+  S21Matrix a(2, 3), b(2, 3);
+  b(1, 2) = 2;
+  double *buffer = &a(0, 0);
+
+  EXPECT_EQ(&(a += b), &a);
+  EXPECT_EQ(&(a -= b * 0.5), &a);
+  EXPECT_EQ(&(a += b - b * 2.0), &a);
+  EXPECT_EQ(&(a *= 4.0), &a);
+  EXPECT_EQ(&a(0, 0), buffer);
+  EXPECT_EQ(a(1, 2), -4);
+  EXPECT_THROW(a += S21Matrix(3, 2) * 1.0, std::invalid_argument);
+}
+
 TEST(OperatorPlusEqual, PlusEqual) {
   double matrix1[2][2] = {{1, 2}, {3, 4}};
   double matrix2[2][2] = {{2, 3}, {4, 5}};
@@ -1331,6 +1694,870 @@ TEST(move, testleak1) {
   S21Matrix matrix2(std::move(matrix1));
 }
 
+TEST(ThreadPool, ParallelForCoversRange) {
+  S21ThreadPool &pool = S21ThreadPool::Instance();
+  pool.SetThreads(4);
+  EXPECT_EQ(pool.GetThreads(), 4);
+
+  std::vector<int> hits(1000);
+  pool.ParallelFor(0, 1000, 10, [&](int from, int to) {
+    for (int i = from; i < to; i++) hits[i]++;
+  });
+  for (int hit : hits) EXPECT_EQ(hit, 1);
+
+  EXPECT_THROW(pool.ParallelFor(0, 100, 1,
+                                [](int, int) { throw std::runtime_error(""); }),
+               std::runtime_error);
+  pool.SetThreads(0);
+}
+
+TEST(ThreadPool, ParallelMatchesSerial) {
+  S21ThreadPool &pool = S21ThreadPool::Instance();
+  pool.SetThreads(3);
+  pool.SetAffinity({0});
+
+  const int size = 300;
+  S21Matrix first(size, size), second(size, size);
+  for (int i = 0; i < size; i++) {
+    for (int j = 0; j < size; j++) {
+      first(i, j) = (i * 3 + j) % 7 - 3;
+      second(i, j) = (i + j * 5) % 9 - 4;
+    }
+  }
+
+  S21Matrix parallel = first * second, serial;
+  {
+    S21Parallelism policy(1);
+    EXPECT_EQ(S21Parallelism::Current(), 1);
+    serial = first * second;
+  }
+  EXPECT_EQ(S21Parallelism::Current(), 3);
+  EXPECT_TRUE(parallel == serial);
+  EXPECT_EQ(parallel(17, 250), serial(17, 250));
+
+  parallel.SumMatrix(first);
+  parallel.MulNumber(2);
+  EXPECT_DOUBLE_EQ(parallel(5, 9), 2 * (serial(5, 9) + first(5, 9)));
+  for (int i = 0; i < size; i++) first(i, i) += 4 * size;
+  S21Matrix identity = first * first.InverseMatrix();
+  for (int i = 0; i < size; i++) identity(i, i) -= 1;
+  EXPECT_TRUE(identity == S21Matrix(size, size));
+
+  pool.SetAffinity({});
+  pool.SetThreads(0);
+}
+
+TEST(FixedMatrix, ConstexprClosedForms) {
+  constexpr S21FixedMatrix<2, 2> a{4, 7, 2, 6};
+  static_assert(a.Determinant() == 10);
+  static_assert(a.InverseMatrix() * a == S21FixedMatrix<2, 2>{1, 0, 0, 1});
+  constexpr S21FixedMatrix<2, 3> b{1, 2, 3, 4, 5, 6};
+  static_assert((a * b)(1, 2) == 2 * 3 + 6 * 6);
+  static_assert(b.Transpose().GetRows() == 3);
+  static_assert((a + a - 2 * a) == S21FixedMatrix<2, 2>());
+}
+
+TEST(FixedMatrix, MatchesDynamic) {
+  using Fixed4 = S21FixedMatrix<4, 4>;
+  using Fixed3 = S21FixedMatrix<3, 3>;
+  Fixed4 fixed;
+  S21Matrix dynamic(4, 4);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      fixed(i, j) = dynamic(i, j) = (i * 5 + j * 3) % 7 + (i == j) * 4;
+    }
+  }
+  EXPECT_NEAR(fixed.Determinant(), dynamic.Determinant(), 1e-9);
+  EXPECT_TRUE(S21Matrix(fixed.InverseMatrix()) == dynamic.InverseMatrix());
+  EXPECT_TRUE(S21Matrix(fixed.CalcComplements()) ==
+              dynamic.CalcComplements());
+  EXPECT_TRUE(S21Matrix(fixed * fixed) == dynamic * dynamic);
+  EXPECT_TRUE(Fixed4(dynamic) == fixed);
+
+  S21FixedMatrix<6, 6> large;
+  for (int i = 0; i < 6; i++) large(i, i) = 2;
+  EXPECT_DOUBLE_EQ(large.Determinant(), 64);
+  EXPECT_DOUBLE_EQ(large.InverseMatrix()(5, 5), 0.5);
+
+  EXPECT_THROW(Fixed3{dynamic}, std::invalid_argument);
+  EXPECT_THROW(Fixed3().InverseMatrix(), std::logic_error);
+  // det 1e-9, yet every pivot is healthy
+  Fixed3 small;
+  for (int i = 0; i < 3; i++) small(i, i) = 1e-3;
+  EXPECT_DOUBLE_EQ(small.InverseMatrix()(2, 2), 1e3);
+  EXPECT_THROW((Fixed3{1, 2, 3, 2, 4, 6, 1, 0, 1}.InverseMatrix()),
+               std::logic_error);
+}
+
+TEST(ElementTypes, FloatMatchesDouble) {
+  const int size = 70;
+  S21MatrixF single(size, size);
+  S21Matrix twice(size, size);
+  for (int i = 0; i < size; i++) {
+    for (int j = 0; j < size; j++) {
+      twice(i, j) = single(i, j) = ((i * 7 + j * 3) % 11) / 4.0f + (i == j) * 8;
+    }
+  }
+  S21MatrixF product = single * single + single * 2.0f;
+  S21Matrix reference = twice * twice + twice * 2.0;
+  for (int i = 0; i < size; i++) {
+    for (int j = 0; j < size; j++) {
+      EXPECT_NEAR(product(i, j), reference(i, j), 1e-5 * reference(i, j));
+    }
+  }
+  S21MatrixF identity(size, size);
+  for (int i = 0; i < size; i++) identity(i, i) = 1;
+  EXPECT_TRUE(single * single.InverseMatrix() == identity);
+  single.SetRows(10), single.SetCols(10);
+  twice.SetRows(10), twice.SetCols(10);
+  EXPECT_NEAR(single.Determinant() / twice.Determinant(), 1, 1e-5);
+}
+
+TEST(ElementTypes, IntegersAreExact) {
+  S21MatrixI64 mat(5, 5);
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) mat(i, j) = (i * 3 + j * 5) % 7 - 3;
+  }
+  S21Matrix reference(5, 5);
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) reference(i, j) = mat(i, j);
+  }
+  EXPECT_EQ(mat.Determinant(), std::llround(reference.Determinant()));
+  S21MatrixI64 complements = mat.CalcComplements();
+  S21Matrix expected = reference.CalcComplements();
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) {
+      EXPECT_EQ(complements(i, j), std::llround(expected(i, j)));
+    }
+  }
+  EXPECT_THROW(mat.InverseMatrix(), std::logic_error);
+
+  // upper unitriangular: det 1, so the inverse is integral
+  S21MatrixI64 unimodular(4, 4);
+  for (int i = 0; i < 4; i++) {
+    for (int j = i; j < 4; j++) unimodular(i, j) = i == j ? 1 : i + j;
+  }
+  S21MatrixI64 identity(4, 4);
+  for (int i = 0; i < 4; i++) identity(i, i) = 1;
+  EXPECT_TRUE(unimodular * unimodular.InverseMatrix() == identity);
+  identity(0, 1) = 1;
+  EXPECT_FALSE(unimodular * unimodular.InverseMatrix() == identity);
+}
+
+TEST(ElementTypes, ComplexInverse) {
+  using Complex = std::complex<double>;
+  const int size = 12;
+  S21MatrixC mat(size, size), identity(size, size);
+  for (int i = 0; i < size; i++) {
+    for (int j = 0; j < size; j++) {
+      mat(i, j) = Complex((i + 2 * j) % 5, (i * j) % 3 - 1.0);
+    }
+    mat(i, i) += Complex(0, 10);
+    identity(i, i) = 1;
+  }
+  EXPECT_TRUE(mat * mat.InverseMatrix() == identity);
+  EXPECT_TRUE(mat.Transpose().Transpose() == mat);
+  S21MatrixC doubled = mat + mat;
+  EXPECT_TRUE(doubled == mat * Complex(2, 0));
+}
+
+TEST(SparseMatrix, DenseRoundTrip) {
+  S21Matrix dense(5, 7);
+  for (int i = 0; i < 5; i++) dense(i, (3 * i) % 7) = i + 1;
+  dense(1, 6) = 1e-9;
+  S21SparseMatrix kept(dense), dropped(dense, 1e-6);
+  EXPECT_EQ(kept.GetNonZeros(), 6);
+  EXPECT_EQ(dropped.GetNonZeros(), 5);
+  EXPECT_DOUBLE_EQ(kept.At(1, 6), 1e-9);
+  EXPECT_DOUBLE_EQ(dropped.At(4, 5), 5);
+  EXPECT_DOUBLE_EQ(dropped.At(4, 4), 0);
+  EXPECT_TRUE(kept.ToDense() == dense);
+  EXPECT_TRUE(kept == dropped);
+  EXPECT_ANY_THROW(kept.At(5, 0));
+  EXPECT_ANY_THROW(S21SparseMatrix(2, 2, {0, 1, 2}, {1, 0, 1}, {1, 2, 3}));
+  EXPECT_ANY_THROW(S21SparseMatrix(2, 2, {0, 2, 2}, {1, 0}, {1, 2}));
+}
+
+TEST(SparseMatrix, CscRoundTrip) {
+  S21SparseMatrix mat(3, 4, {0, 2, 2, 4}, {0, 3, 1, 2}, {1, 2, 3, 4});
+  std::vector<int> colPtr, rowIndex;
+  std::vector<double> values;
+  mat.ToCsc(colPtr, rowIndex, values);
+  EXPECT_EQ(colPtr, std::vector<int>({0, 1, 2, 3, 4}));
+  EXPECT_EQ(rowIndex, std::vector<int>({0, 2, 2, 0}));
+  EXPECT_EQ(values, std::vector<double>({1, 3, 4, 2}));
+  S21SparseMatrix back = S21SparseMatrix::FromCsc(3, 4, colPtr, rowIndex,
+                                                  values);
+  EXPECT_EQ(back.GetColIndex(), mat.GetColIndex());
+  EXPECT_TRUE(back.Transpose().ToDense() == mat.ToDense().Transpose());
+}
+
+TEST(SparseMatrix, ArithmeticMatchesDense) {
+  S21Matrix a(30, 40), b(30, 40), c(40, 25);
+  for (int i = 0; i < 40; i++) {
+    a(i % 30, i) = i - 7.5, b(i % 30, (i * 7) % 40) = 0.5 * i;
+    c(i, i % 25) = 2 - i, c(i, (i * 3) % 25) += 1;
+  }
+  b(0, 0) = -a(0, 0);
+  const S21SparseMatrix sa(a), sb(b), sc(c);
+  S21Matrix sum = a + b, product = a * c, lhs = b.Transpose() * a;
+  EXPECT_TRUE((sa + sb).ToDense() == sum);
+  EXPECT_LT((sa + sb).GetNonZeros(), sa.GetNonZeros() + sb.GetNonZeros());
+  EXPECT_TRUE((sa - sb).ToDense() == a - b);
+  EXPECT_TRUE((sa * 3.0).ToDense() == a * 3.0);
+  EXPECT_TRUE((sa * sc).ToDense() == product);
+  EXPECT_TRUE(sa * c == product);
+  EXPECT_TRUE(a * sc == product);
+  EXPECT_TRUE((sb.Transpose() * sa).ToDense() == lhs);
+  EXPECT_ANY_THROW(sa + sc);
+  EXPECT_ANY_THROW(sa * sb);
+  EXPECT_ANY_THROW(a * sa);
+}
+
+TEST(SparseMatrix, IntegerElements) {
+  S21MatrixI64 dense(4, 4);
+  for (int i = 0; i < 4; i++) dense(i, 3 - i) = i + 1;
+  S21BasicSparseMatrix<std::int64_t> mat(dense);
+  EXPECT_TRUE((mat * mat).ToDense() == dense * dense);
+  EXPECT_TRUE((mat - mat).GetNonZeros() == 0);
+}
+
+TEST(Persistence, SaveAndMap) {
+  const char *path = "s21_test_matrix.bin";
+  S21Matrix mat(37, 5);
+  for (int i = 0; i < 37; i++) {
+    for (int j = 0; j < 5; j++) mat(i, j) = i * 5 + j - 0.25;
+  }
+  mat.Save(path);
+  const S21Matrix mapped = S21Matrix::OpenMapped(path, kS21ReadOnly, true);
+  EXPECT_TRUE(mapped == mat);
+  S21Matrix copy = mapped;
+  copy(0, 0) = 100;
+  EXPECT_FALSE(copy == mapped);
+
+  S21Matrix cow = S21Matrix::OpenMapped(path, kS21CopyOnWrite);
+  cow(3, 4) = -1;
+  cow *= 2.0;
+  EXPECT_TRUE(S21Matrix::OpenMapped(path) == mat);
+  EXPECT_DOUBLE_EQ(cow(0, 1), 1.5);
+  EXPECT_DOUBLE_EQ(cow(3, 4), -2);
+  cow = mat;
+  EXPECT_TRUE(cow == mat);
+
+  EXPECT_ANY_THROW(S21MatrixF::OpenMapped(path));
+  EXPECT_ANY_THROW(S21Matrix::OpenMapped("no_such_matrix.bin"));
+  std::remove(path);
+}
+
+TEST(Persistence, WritesNeverReachMappedPages) {
+  const char *path = "s21_test_matrix.bin";
+  S21Matrix mat(40, 40), other(40, 40);
+  for (int i = 0; i < 40; i++) {
+    for (int j = 0; j < 40; j++) mat(i, j) = i - 2.0 * j + (i == j) * 100;
+  }
+  mat.Save(path);
+  // each read-only mapping turns into a private copy on its first write
+  S21Matrix mapped[7];
+  for (S21Matrix &each : mapped) each = S21Matrix::OpenMapped(path);
+  mapped[0](0, 0) = 5;
+  mapped[1].SumMatrix(mat);
+  mapped[2] *= 2.0;
+  mapped[3].TransposeInPlace();
+  mapped[4] = mapped[4] - mat;
+  mapped[5].Block(0, 0, 2, 2).Fill(1);
+  std::vector<int> pivots(40);
+  EXPECT_NEAR(mapped[6].FactorLU(pivots.data()) / mat.Determinant(), 1,
+              1e-9);
+  EXPECT_DOUBLE_EQ(mapped[0](0, 0), 5);
+  EXPECT_TRUE(mapped[1] == mat * 2.0);
+  EXPECT_TRUE(mapped[2] == mat * 2.0);
+  EXPECT_TRUE(mapped[3] == mat.Transpose());
+  EXPECT_TRUE(mapped[4] == other);
+  EXPECT_DOUBLE_EQ(mapped[5](1, 1), 1);
+  EXPECT_TRUE(S21Matrix::OpenMapped(path, kS21ReadOnly, true) == mat);
+
+  // saving over a mapped file leaves the old mapping whole
+  const S21Matrix live = S21Matrix::OpenMapped(path);
+  other.Save(path);
+  EXPECT_TRUE(live == mat);
+  EXPECT_TRUE(S21Matrix::OpenMapped(path, kS21ReadOnly, true) == other);
+  EXPECT_EQ(std::fopen("s21_test_matrix.bin.tmp", "rb"), nullptr);
+  std::remove(path);
+}
+
+TEST(Persistence, DetectsCorruption) {
+  const char *path = "s21_test_matrix.bin";
+  S21MatrixC mat(3, 3);
+  mat(1, 2) = std::complex<double>(1, -2);
+  mat.Save(path);
+  EXPECT_TRUE(S21MatrixC::OpenMapped(path, kS21ReadOnly, true) == mat);
+  std::FILE *file = std::fopen(path, "r+b");
+  std::fseek(file, 64 + 16, SEEK_SET);
+  std::fputc(7, file);
+  std::fclose(file);
+  EXPECT_NO_THROW(S21MatrixC::OpenMapped(path));
+  EXPECT_ANY_THROW(S21MatrixC::OpenMapped(path, kS21ReadOnly, true));
+  file = std::fopen(path, "ab");
+  std::fputc(0, file);
+  std::fclose(file);
+  EXPECT_ANY_THROW(S21MatrixC::OpenMapped(path));
+  std::remove(path);
+  EXPECT_THROW(S21MatrixC().Save(path), std::logic_error);
+  EXPECT_EQ(std::fopen(path, "rb"), nullptr);
+}
+
+TEST(Persistence, ProductOutOfCore) {
+  S21Matrix lhs(70, 45), rhs(45, 33);
+  for (int i = 0; i < 70; i++) {
+    for (int j = 0; j < 45; j++) lhs(i, j) = ((i * 7 + j * 3) % 11) - 5.5;
+  }
+  for (int i = 0; i < 45; i++) {
+    for (int j = 0; j < 33; j++) rhs(i, j) = ((i * 5 + j) % 13) * 0.25;
+  }
+  lhs.Save("s21_test_lhs.bin"), rhs.Save("s21_test_rhs.bin");
+  // 16 x 16 tiles: every dimension needs several, the last ones partial
+  S21Matrix::ProductOutOfCore("s21_test_lhs.bin", "s21_test_rhs.bin",
+                              "s21_test_product.bin", 5 * 16 * 16 * 8);
+  const S21Matrix product =
+      S21Matrix::OpenMapped("s21_test_product.bin", kS21ReadOnly, true);
+  EXPECT_TRUE(product == lhs * rhs);
+  S21Matrix::ProductOutOfCore("s21_test_lhs.bin", "s21_test_rhs.bin",
+                              "s21_test_product.bin");
+  EXPECT_TRUE(S21Matrix::OpenMapped("s21_test_product.bin", kS21ReadOnly,
+                                    true) == lhs * rhs);
+  EXPECT_ANY_THROW(S21Matrix::ProductOutOfCore(
+      "s21_test_rhs.bin", "s21_test_rhs.bin", "s21_test_product.bin"));
+  std::remove("s21_test_lhs.bin"), std::remove("s21_test_rhs.bin");
+  std::remove("s21_test_product.bin");
+}
+
+TEST(MatrixView, SlicesShareStorage) {
+  S21Matrix mat(4, 6);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 6; j++) mat(i, j) = i * 10 + j;
+  }
+  S21MatrixView block = mat.Block(1, 2, 2, 3);
+  EXPECT_EQ(block.GetRows(), 2);
+  EXPECT_DOUBLE_EQ(block(1, 2), 24);
+  block(0, 0) = -1;
+  EXPECT_DOUBLE_EQ(mat(1, 2), -1);
+  EXPECT_DOUBLE_EQ(mat.Col(5)(3, 0), 35);
+  EXPECT_DOUBLE_EQ(mat.Row(3).Transposed()(4, 0), 34);
+  S21MatrixView strided = S21MatrixView(mat).Strided(2, 3);
+  EXPECT_EQ(strided.GetCols(), 2);
+  EXPECT_DOUBLE_EQ(strided(1, 1), 23);
+  EXPECT_ANY_THROW(mat.Block(3, 0, 2, 1));
+  EXPECT_ANY_THROW(block(2, 0));
+  EXPECT_ANY_THROW(mat.Row(-1));
+
+  const S21Matrix &constant = mat;
+  static_assert(std::is_same_v<decltype(constant.Row(0)),
+                               S21BasicMatrixView<const double>>);
+  S21ConstMatrixView whole = constant;
+  EXPECT_TRUE(whole == mat);
+  EXPECT_TRUE(S21Matrix(whole.Transposed()) == mat.Transpose());
+  const S21Matrix transposed = mat.Transpose();
+  const S21Matrix corner = whole.Block(0, 0, 3, 3).Transpose();
+  EXPECT_TRUE(transposed.Block(0, 0, 3, 3) == corner);
+  // a view of a temporary would dangle, so it does not compile
+  static_assert(!std::is_convertible_v<S21Matrix &&, S21ConstMatrixView>);
+  static_assert(std::is_convertible_v<const S21Matrix &, S21ConstMatrixView>);
+}
+
+TEST(MatrixView, InPlaceArithmetic) {
+  S21Matrix mat(5, 5), expected(5, 5);
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) mat(i, j) = expected(i, j) = i - 2 * j;
+  }
+  mat.Block(0, 0, 2, 2) += mat.Block(3, 3, 2, 2);
+  mat.Row(4).MulNumber(2);
+  mat.Col(2) -= mat.Col(0);
+  mat.Block(2, 0, 2, 2).Transposed().Assign(mat.Block(0, 3, 2, 2));
+  for (int i = 0; i < 2; i++) {
+    for (int j = 0; j < 2; j++) expected(i, j) += expected(i + 3, j + 3);
+  }
+  for (int j = 0; j < 5; j++) expected(4, j) *= 2;
+  for (int i = 0; i < 5; i++) expected(i, 2) -= expected(i, 0);
+  for (int i = 0; i < 2; i++) {
+    for (int j = 0; j < 2; j++) expected(2 + j, i) = expected(i, 3 + j);
+  }
+  EXPECT_TRUE(mat == expected);
+  EXPECT_FALSE(mat.Row(0) == mat.Row(1));
+  EXPECT_ANY_THROW(mat.Row(0) += mat.Col(0));
+  EXPECT_DOUBLE_EQ(mat.Block(1, 1, 2, 2).Determinant(),
+                   mat(1, 1) * mat(2, 2) - mat(1, 2) * mat(2, 1));
+  mat.Block(1, 1, 3, 3).Fill(0);
+  EXPECT_DOUBLE_EQ(mat(3, 3), 0);
+}
+
+TEST(MatrixView, MatrixOperandsAndProducts) {
+  S21Matrix mat(70, 70);
+  for (int i = 0; i < 70; i++) {
+    for (int j = 0; j < 70; j++) mat(i, j) = (i * 7 + j * 3) % 11 - 5.0;
+  }
+  const S21Matrix &constant = mat;
+  const S21ConstMatrixView lhs = constant.Block(0, 0, 40, 30),
+                           rhs = constant.Block(5, 10, 30, 50);
+  const S21Matrix a(lhs), b(rhs), expected = a * b;
+  EXPECT_TRUE(S21Matrix::Product(lhs, rhs) == expected);
+  // blocks of one buffer go through S21Gemm, transposed views the loop
+  S21Matrix sum(40, 50), transposed(30, 40);
+  sum.Block(0, 0, 40, 50).AddProduct(lhs, rhs);
+  sum.Block(0, 0, 40, 50).AddProduct(lhs, rhs);
+  EXPECT_TRUE(sum == expected * 2.0);
+  transposed.Block(0, 0, 30, 40).AddProduct(lhs.Transposed(),
+                                            constant.Block(0, 0, 40, 40));
+  EXPECT_TRUE(transposed ==
+              a.Transpose() * S21Matrix(constant.Block(0, 0, 40, 40)));
+  EXPECT_THROW(sum.Block(0, 0, 40, 50).AddProduct(rhs, lhs),
+               std::invalid_argument);
+
+  S21Matrix x = a;
+  x.SumMatrix(lhs);
+  EXPECT_TRUE(x == a * 2.0);
+  x.SubMatrix(lhs);
+  EXPECT_TRUE(x.EqMatrix(lhs));
+  EXPECT_FALSE(x.EqMatrix(rhs));
+  x.MulMatrix(rhs);
+  EXPECT_TRUE(x == expected);
+  EXPECT_THROW(x.SumMatrix(lhs), std::invalid_argument);
+  EXPECT_DOUBLE_EQ(constant.Block(3, 3, 6, 6).Determinant(),
+                   S21Matrix(constant.Block(3, 3, 6, 6)).Determinant());
+}
+
+TEST(MatrixBatch, MatchesSingleMatrices) {
+  // 21 entries: two full groups of eight doubles and a partial one; at 50
+  // every kernel hands its entries to the single-matrix paths
+  const int count = 21;
+  for (int n : {5, 50}) {
+    S21MatrixBatch lhs(count, n, n), rhs(count, n, 3);
+    for (int b = 0; b < count; b++) {
+      for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++)
+          lhs(b, i, j) = ((b + i * 3 + j * 7) % 9) - 4 + (i == j) * 20;
+        for (int j = 0; j < 3; j++) rhs(b, i, j) = (b * j + i) % 5 * 0.5;
+      }
+    }
+    // zero leading entries make pivoting swap rows
+    lhs(3, 0, 0) = 0, lhs(3, 1, 0) = 0;
+    const std::vector<double> det = lhs.BatchDeterminant();
+    const S21MatrixBatch inverse = lhs.BatchInverse();
+    S21MatrixBatch product = lhs;
+    product.BatchMulMatrix(rhs);
+    ASSERT_EQ(det.size(), std::size_t(count));
+    for (int b = 0; b < count; b++) {
+      const S21Matrix single = lhs.GetMatrix(b);
+      EXPECT_NEAR(det[b] / single.Determinant(), 1, 1e-12);
+      EXPECT_TRUE(inverse.GetMatrix(b) == single.InverseMatrix());
+      EXPECT_TRUE(product.GetMatrix(b) == single * rhs.GetMatrix(b));
+    }
+    EXPECT_EQ(product.GetCols(), 3);
+    EXPECT_ANY_THROW(product.BatchDeterminant());
+    EXPECT_ANY_THROW(lhs.BatchMulMatrix(S21MatrixBatch(count - 1, n, n)));
+    EXPECT_ANY_THROW(lhs(count, 0, 0));
+  }
+}
+
+TEST(MatrixBatch, SingularAndExact) {
+  S21MatrixBatch batch(3, 2, 2);
+  batch.SetMatrix(0, S21Matrix(2, 2));
+  for (int b = 0; b < 3; b++) batch(b, 0, 0) = batch(b, 1, 1) = b;
+  EXPECT_ANY_THROW(batch.BatchInverse());
+  EXPECT_DOUBLE_EQ(batch.BatchDeterminant()[2], 4);
+  std::vector<int> singular;
+  const S21MatrixBatch partial = batch.BatchInverse(&singular);
+  EXPECT_EQ(singular, std::vector<int>({0}));
+  EXPECT_DOUBLE_EQ(partial(0, 0, 0), 0);
+  EXPECT_DOUBLE_EQ(partial(2, 1, 1), 0.5);
+  // det(0.6 * I) is about 1e-9 at 40 x 40, yet every pivot is healthy, and
+  // past the interleaved sizes S21LU is the one to judge them
+  S21MatrixBatch scaled(9, 40, 40);
+  for (int b = 0; b < 9; b++)
+    for (int i = 0; i < 40; i++) scaled(b, i, i) = 0.6;
+  EXPECT_DOUBLE_EQ(scaled.BatchInverse(&singular)(8, 39, 39), 1 / 0.6);
+  EXPECT_TRUE(singular.empty());
+  scaled(4, 20, 20) = 0;
+  EXPECT_DOUBLE_EQ(scaled.BatchInverse(&singular)(8, 39, 39), 1 / 0.6);
+  EXPECT_EQ(singular, std::vector<int>({4}));
+  EXPECT_ANY_THROW(scaled.BatchInverse());
+
+  S21BasicMatrixBatch<std::int64_t> exact(2, 2, 2);
+  exact(0, 0, 0) = 2, exact(0, 0, 1) = 1, exact(0, 1, 0) = 1,
+  exact(0, 1, 1) = 1;
+  exact(1, 0, 0) = exact(1, 1, 1) = -1;
+  EXPECT_EQ(exact.BatchDeterminant(), std::vector<std::int64_t>({1, 1}));
+  const S21BasicMatrixBatch<std::int64_t> inverse = exact.BatchInverse();
+  EXPECT_EQ(inverse(0, 0, 1), -1);
+  EXPECT_EQ(inverse(0, 1, 1), 2);
+  exact(1, 0, 0) = 0;
+  exact.BatchInverse(&singular);
+  EXPECT_EQ(singular, std::vector<int>({1}));
+  EXPECT_ANY_THROW(S21MatrixBatch(0, 3, 3));
+}
+
+TEST(Vector, MatchesMulMatrix) {
+  S21Matrix matrix(37, 45), column(45, 1), row(37, 1);
+  S21Vector x(45), z(37);
+  for (int i = 0; i < 37; i++)
+    for (int j = 0; j < 45; j++) matrix(i, j) = (i * 7 + j * 3) % 11 - 5.5;
+  for (int j = 0; j < 45; j++) column(j, 0) = x(j) = j * 0.25 - 3;
+  for (int i = 0; i < 37; i++) row(i, 0) = z(i) = 1.5 - i * 0.125;
+
+  S21Vector y = matrix * x;
+  EXPECT_EQ(y, S21Vector((matrix * column).Col(0)));
+  const S21Vector w = matrix.MulTransposed(z);
+  EXPECT_EQ(w, S21Vector((matrix.Transpose() * row).Col(0)));
+
+  // the output is reused, and x may be y
+  const double *storage = y.Data();
+  matrix.Mul(x, y);
+  EXPECT_EQ(y.Data(), storage);
+  S21Vector both = z;
+  matrix.MulTransposed(both, both);
+  EXPECT_EQ(both, w);
+  EXPECT_THROW(matrix.Mul(z), std::invalid_argument);
+  EXPECT_THROW(matrix.MulTransposed(x), std::invalid_argument);
+}
+
+TEST(Vector, Arithmetic) {
+  S21Matrix matrix(3, 4);
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 4; j++) matrix(i, j) = i * 4 + j;
+  S21Vector row(matrix.Row(1)), col(matrix.Col(2));
+  EXPECT_EQ(row.GetSize(), 4);
+  EXPECT_EQ(col.GetSize(), 3);
+  EXPECT_EQ(col(2), 10);
+  EXPECT_THROW(S21Vector{matrix.Block(0, 0, 2, 2)}, std::invalid_argument);
+
+  EXPECT_EQ(row.Dot(row), 16 + 25 + 36 + 49);
+  S21Vector sum = row + row * 2.0 - row;
+  sum.Axpy(-2, row);
+  EXPECT_EQ(sum.Dot(sum), 0);
+  row.SetSize(2);
+  EXPECT_EQ(row.GetSize(), 2);
+  EXPECT_EQ(row(1), 5);
+  EXPECT_THROW(row(2), std::out_of_range);
+  EXPECT_THROW(row.Dot(col), std::invalid_argument);
+  S21Vector empty;
+  empty.SetSize(3);
+  EXPECT_EQ(empty.GetSize(), 3);
+  EXPECT_EQ(empty(2), 0);
+  EXPECT_THROW(empty.SetSize(0), std::invalid_argument);
+
+  col.AsCol() *= 2;
+  EXPECT_EQ(col(1), 12);
+  EXPECT_TRUE(S21Matrix(col.AsCol()) == S21Matrix(col.AsRow()).Transpose());
+}
+
+TEST(LU, SolvesAgainstStoredFactors) {
+  // past one LU_BLOCK panel, so the blocked update runs
+  const int n = 150;
+  S21Matrix matrix(n, n), many(n, 3);
+  S21Vector b(n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) matrix(i, j) = (i * 13 + j * 7) % 17 - 8.0;
+    matrix(i, (i * 7) % n) += 40;
+    b(i) = i % 5 - 2.0;
+    for (int j = 0; j < 3; j++) many(i, j) = (i + j) % 4;
+  }
+  const S21LU lu(matrix);
+  EXPECT_FALSE(lu.IsSingular());
+  EXPECT_NEAR(lu.Determinant() / matrix.Determinant(), 1, 1e-9);
+
+  const S21Vector x = lu.Solve(b);
+  EXPECT_TRUE(matrix * x == b);
+  S21Vector again = b;
+  lu.SolveInPlace(again);
+  EXPECT_TRUE(again == x);
+  EXPECT_TRUE(S21Matrix(matrix * lu.Solve(many)) == many);
+  EXPECT_TRUE(lu.Inverse() == matrix.InverseMatrix());
+  EXPECT_THROW(lu.Solve(S21Vector(n - 1)), std::invalid_argument);
+}
+
+TEST(LU, SingularAndNonSquare) {
+  S21Matrix matrix(3, 3);
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++) matrix(i, j) = i + j;
+  const S21LU lu(matrix);
+  EXPECT_TRUE(lu.IsSingular());
+  EXPECT_NEAR(lu.Determinant(), 0, EPS);
+  EXPECT_THROW(lu.Solve(S21Vector(3)), std::logic_error);
+  EXPECT_THROW(lu.Inverse(), std::logic_error);
+  EXPECT_THROW(S21LU(S21Matrix(2, 3)), std::logic_error);
+  // a tiny determinant with healthy pivots still solves
+  S21Matrix half(30, 30);
+  S21Vector ones(30);
+  for (int i = 0; i < 30; i++) half(i, i) = 0.5, ones(i) = 1;
+  const S21LU scaled(half);
+  EXPECT_FALSE(scaled.IsSingular());
+  EXPECT_DOUBLE_EQ(scaled.Solve(ones)(29), 2);
+  EXPECT_DOUBLE_EQ(scaled.Inverse()(0, 0), 2);
+
+  S21BasicMatrix<std::complex<double>> complex(2, 2);
+  complex(0, 0) = {0, 1}, complex(0, 1) = 2, complex(1, 0) = 1;
+  const S21BasicLU<std::complex<double>> factors(complex);
+  EXPECT_NEAR(std::abs(factors.Determinant() - complex.Determinant()), 0,
+              EPS);
+}
+
+TEST(Cholesky, FactorsAndSolvesSpd) {
+  // past one CHOLESKY_BLOCK panel, so the blocked update runs
+  const int n = 150;
+  S21Matrix root(n, n), many(n, 2);
+  S21Vector b(n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) root(i, j) = ((i * 13 + j * 7) % 17 - 8.0) / n;
+    b(i) = i % 5 - 2.0;
+    many(i, 0) = i % 3, many(i, 1) = 1;
+  }
+  S21Matrix matrix = root * root.Transpose();
+  for (int i = 0; i < n; i++) matrix(i, i) += 1;
+  const S21Matrix input = matrix;
+
+  const S21Cholesky llt(matrix);
+  const S21Matrix &l = llt.GetFactor();
+  EXPECT_EQ(l.Row(0)(0, n - 1), 0);
+  EXPECT_TRUE(S21Matrix(l * l.Transpose()) == input);
+  EXPECT_NEAR(llt.LogDeterminant(), std::log(S21LU(input).Determinant()),
+              1e-9);
+  EXPECT_TRUE(input * llt.Solve(b) == b);
+  EXPECT_TRUE(S21Matrix(input * llt.Solve(many)) == many);
+  EXPECT_TRUE(llt.Inverse() == input.InverseMatrix());
+  EXPECT_THROW(llt.Solve(S21Vector(n + 1)), std::invalid_argument);
+}
+
+TEST(Cholesky, NearlySemidefinite) {
+  // A = L * L^T with the last 50 rows of L scaled by 1e-5 past column 100,
+  // so the trailing Schur complement, and the smallest eigenvalue of A, sit
+  // near 1e-10 while the rounding in them stays near 1e-13
+  const int n = 150, k = 100;
+  const double tiny = 1e-5;
+  S21Matrix root(n, n);
+  S21Vector b(n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < i; j++) root(i, j) = ((i * 13 + j * 7) % 17 - 8.0) / n;
+    root(i, i) = 1;
+    for (int j = k; i >= k && j <= i; j++) root(i, j) *= tiny;
+    b(i) = i % 5 - 2.0;
+  }
+  S21Matrix matrix = root * root.Transpose();
+  const S21Matrix input = matrix;
+
+  const S21Cholesky llt(matrix);
+  const S21Matrix &l = llt.GetFactor();
+  EXPECT_TRUE(S21Matrix(l * l.Transpose()) == input);
+  EXPECT_NEAR(llt.LogDeterminant(), 2 * (n - k) * std::log(tiny), 1e-2);
+  // backward stable: the residual is rounding next to |A| |x|, though x
+  // itself runs past 1e11
+  const S21Vector x = llt.Solve(b), residual = input * x - b;
+  double normA = 0;
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j < n; j++) normA = std::max(normA, std::abs(matrix(i, j)));
+  EXPECT_GT(std::sqrt(x.Dot(x)), 1e10);
+  EXPECT_LT(std::sqrt(residual.Dot(residual)),
+            1e-15 * n * normA * std::sqrt(x.Dot(x)));
+
+  // 1e-7 below the diagonal takes A past semidefinite
+  for (int i = 0; i < n; i++) matrix(i, i) -= 1e-7;
+  EXPECT_THROW(S21Cholesky{matrix}, std::logic_error);
+}
+
+TEST(Cholesky, RejectsIndefinite) {
+  S21Matrix matrix(3, 3);
+  matrix(0, 0) = 4, matrix(1, 1) = -1, matrix(2, 2) = 9;
+  EXPECT_THROW(S21Cholesky{matrix}, std::logic_error);
+  EXPECT_THROW(S21Cholesky{S21Matrix(2, 3)}, std::logic_error);
+
+  // Hermitian positive definite: [[2, i], [-i, 2]], only its lower half read
+  S21MatrixC hermitian(2, 2);
+  hermitian(0, 0) = hermitian(1, 1) = 2, hermitian(1, 0) = {0, -1};
+  hermitian(0, 1) = 99;
+  const S21BasicCholesky<std::complex<double>> llt(hermitian);
+  EXPECT_NEAR(llt.LogDeterminant(), std::log(3.0), 1e-12);
+  S21BasicVector<std::complex<double>> b(2);
+  b(0) = 1, b(1) = {0, 1};
+  const auto x = llt.Solve(b);
+  hermitian(0, 1) = {0, 1};
+  EXPECT_TRUE(hermitian * x == b);
+}
+
+TEST(QR, FactorsAcrossPanels) {
+  // a panel short of, exactly at and one column past QR_BLOCK = 32, and
+  // several panels; square, one row over square, and past one QR_CHUNK of
+  // transposed reflectors
+  for (int n : {31, 32, 33, 70}) {
+    for (int m : {n, n + 1, 5000}) {
+      S21Matrix matrix(m, n);
+      S21Vector b(m);
+      for (int i = 0; i < m; i++) {
+        for (int j = 0; j < n; j++)
+          matrix(i, j) = std::sin(i * 0.37 + j * j * 0.11) + (i == j) * 2;
+        b(i) = std::cos(i * 0.5);
+      }
+      const S21QR qr(matrix);
+      const S21Matrix q = qr.GetThinQ(), r = qr.GetR();
+      S21Matrix identity(n, n);
+      for (int i = 0; i < n; i++) identity(i, i) = 1;
+      EXPECT_TRUE(S21Matrix(q.Transpose() * q) == identity);
+      EXPECT_TRUE(S21Matrix(q * r) == matrix);
+      EXPECT_EQ(r.Row(n - 1)(0, 0), 0);
+
+      // the residual is orthogonal to the columns, and zero when square
+      const S21Vector x = qr.LeastSquares(b);
+      EXPECT_TRUE(matrix.MulTransposed(matrix * x - b) == S21Vector(n));
+      EXPECT_TRUE(m > n || matrix * x == b);
+      S21Matrix many(m, 2);
+      for (int i = 0; i < m; i++) many(i, 0) = b(i), many(i, 1) = 1;
+      const S21Matrix xs = qr.LeastSquares(many);
+      EXPECT_TRUE(S21Vector(xs.Col(0)) == x);
+    }
+  }
+}
+
+TEST(QR, RejectsWideAndRankDeficient) {
+  EXPECT_THROW(S21QR(S21Matrix(2, 3)), std::invalid_argument);
+  S21Matrix matrix(4, 2);
+  for (int i = 0; i < 4; i++) matrix(i, 0) = i, matrix(i, 1) = 2 * i;
+  const S21QR qr(matrix);
+  EXPECT_THROW(qr.LeastSquares(S21Vector(4)), std::logic_error);
+  EXPECT_THROW(qr.LeastSquares(S21Vector(3)), std::invalid_argument);
+
+  // square and exact
+  S21Matrix square(2, 2);
+  square(0, 0) = 2, square(0, 1) = 1, square(1, 0) = 1, square(1, 1) = 3;
+  S21Vector b(2);
+  b(0) = 3, b(1) = 5;
+  const S21Vector x = S21QR(square).LeastSquares(b);
+  EXPECT_NEAR(x(0), 0.8, 1e-12);
+  EXPECT_NEAR(x(1), 1.4, 1e-12);
+
+  // independent columns nine orders apart are badly scaled, not deficient
+  S21Matrix design(50, 2);
+  S21Vector line(50);
+  for (int i = 0; i < 50; i++)
+    design(i, 0) = 1, design(i, 1) = 1e-9 * i, line(i) = 3 + 2e-9 * i;
+  const S21Vector fit = S21QR(design).LeastSquares(line);
+  EXPECT_NEAR(fit(0), 3, 1e-9);
+  EXPECT_NEAR(fit(1), 2, 1e-6);
+}
+
+// A * V == V * diag(values) and V^T * V == I
+static void ExpectEigenpairs(const S21Matrix &matrix,
+                             const S21SymmetricEigen &eigen) {
+  S21Matrix vectors = eigen.GetVectors(), scaled = vectors;
+  const int count = eigen.GetCount();
+  S21Matrix identity(count, count);
+  for (int j = 0; j < count; j++) {
+    identity(j, j) = 1;
+    for (int i = 0; i < eigen.GetSize(); i++)
+      scaled(i, j) *= eigen.GetValues()(j);
+  }
+  EXPECT_TRUE(S21Matrix(matrix * vectors) == scaled);
+  EXPECT_TRUE(S21Matrix(vectors.Transpose() * vectors) == identity);
+}
+
+TEST(SymmetricEigen, DecomposesSymmetric) {
+  // several reflector panels, and halves merged past the QL leaves
+  const int n = 150;
+  S21Matrix matrix(n, n);
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j <= i; j++)
+      matrix(i, j) = matrix(j, i) = std::sin(i * 0.37 + j * j * 0.11);
+  const S21Matrix input = matrix;
+  for (int i = 0; i < n; i++)
+    for (int j = i + 1; j < n; j++) matrix(i, j) = 99;
+
+  const S21SymmetricEigen eigen(matrix);
+  ASSERT_EQ(eigen.GetCount(), n);
+  ExpectEigenpairs(input, eigen);
+  double trace = 0;
+  for (int i = 0; i < n; i++) {
+    trace += eigen.GetValues()(i) - matrix(i, i);
+    if (i) {
+      EXPECT_GE(eigen.GetValues()(i - 1), eigen.GetValues()(i));
+    }
+  }
+  EXPECT_NEAR(trace, 0, 1e-9);
+
+  const S21SymmetricEigen values(matrix, false);
+  EXPECT_TRUE(values.GetValues() == eigen.GetValues());
+  EXPECT_EQ(values.GetVectors().GetRows(), 0);
+
+  const S21SymmetricEigen largest(matrix, 5);
+  ExpectEigenpairs(input, largest);
+  for (int j = 0; j < 5; j++)
+    EXPECT_NEAR(largest.GetValues()(j), eigen.GetValues()(j), 1e-9);
+  EXPECT_TRUE(S21SymmetricEigen(matrix, 5, false).GetValues() ==
+              largest.GetValues());
+}
+
+TEST(SymmetricEigen, RepeatedValuesAndErrors) {
+  // four blocks of ones: 25 four times over and 0 for the rest, so most
+  // pairs deflate and the largest form one cluster
+  const int n = 100;
+  S21Matrix matrix(n, n);
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j < n; j++) matrix(i, j) = i / 25 == j / 25;
+  const S21SymmetricEigen eigen(matrix);
+  ExpectEigenpairs(matrix, eigen);
+  EXPECT_NEAR(eigen.GetValues()(3), 25, 1e-9);
+  EXPECT_NEAR(eigen.GetValues()(4), 0, 1e-9);
+  const S21SymmetricEigen largest(matrix, 4);
+  ExpectEigenpairs(matrix, largest);
+
+  EXPECT_THROW(S21SymmetricEigen(S21Matrix(2, 3)), std::logic_error);
+  EXPECT_THROW(S21SymmetricEigen(matrix, n + 1), std::invalid_argument);
+  EXPECT_THROW(S21SymmetricEigen(matrix, 0), std::invalid_argument);
+
+  S21MatrixF pair(2, 2);
+  pair(0, 0) = pair(1, 1) = 2, pair(1, 0) = 1;
+  const S21BasicSymmetricEigen<float> single(pair);
+  EXPECT_NEAR(single.GetValues()(0), 3, 1e-6);
+  EXPECT_NEAR(single.GetValues()(1), 1, 1e-6);
+  EXPECT_NEAR(std::abs(single.GetVectors().Row(0)(0, 0)), std::sqrt(0.5), 1e-6);
+}
+
+// counts only move in a build with -DS21_PROFILE (make test_profile)
+TEST(Profile, CountsCallsAndAllocations) {
+  S21ResetProfile();
+  S21SetTracing(true);
+  {
+    S21Matrix a(4, 4), b(4, 4);
+    a.MulMatrix(b);
+    EXPECT_EQ(a.Determinant(), 0);
+  }
+  S21SetTracing(false);
+  const S21ProfileSnapshot snapshot = S21GetProfile();
+  std::ostringstream json, trace;
+  S21WriteProfileJson(snapshot, json);
+  S21WriteTrace(trace);
+#ifdef S21_PROFILE
+  const auto &methods = snapshot.methods;
+  EXPECT_EQ(methods[kS21ProfileMulMatrix].calls, 1u);
+  EXPECT_EQ(methods[kS21ProfileProduct].calls, 1u);
+  EXPECT_EQ(methods[kS21ProfileDeterminant].calls, 1u);
+  EXPECT_EQ(methods[kS21ProfileInitMatrix].calls, 3u);
+  EXPECT_GE(methods[kS21ProfileMulMatrix].nanoseconds,
+            methods[kS21ProfileProduct].nanoseconds);
+  // a, b, the product and the copy Determinant factors, all freed again
+  EXPECT_GE(snapshot.allocations, 4u);
+  EXPECT_EQ(snapshot.frees, snapshot.allocations);
+  EXPECT_EQ(snapshot.bytes_freed, snapshot.bytes_allocated);
+  EXPECT_GE(snapshot.peak_bytes, 3 * 4 * 4 * sizeof(double));
+  EXPECT_NE(json.str().find("\"MulMatrix\":{\"calls\":1,"),
+            std::string::npos);
+  EXPECT_NE(trace.str().find("{\"name\":\"Product\",\"cat\""),
+            std::string::npos);
+#else
+  EXPECT_EQ(snapshot.methods[kS21ProfileMulMatrix].calls, 0u);
+  EXPECT_EQ(snapshot.allocations, 0u);
+  EXPECT_EQ(json.str().substr(0, 13), "{\"methods\":{}");
+  EXPECT_EQ(trace.str().substr(0, 17), "{\"traceEvents\":[]");
+#endif
+  S21ResetProfile();
+  EXPECT_EQ(S21GetProfile().methods[kS21ProfileMulMatrix].calls, 0u);
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();